@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Collision tests of the arm's moving links against the board, its base, itself and a target.
+ *
+ * Links are capsules of ARM_RADIUS around the segments joint1-joint2 and joint2-end of arm3. The base and targets are
+ * vertical cylinders: a capsule touches one if the part of its segment within the cylinder's height (grown by the
+ * capsule radius) comes closer to the axis than the sum of radii. Self collision is the segment-segment distance
+ * between arm3 and the fixed arm1, and between arm3 past the joint2 pivot and arm2, which catches the arm folding onto
+ * itself. Poses are tested simd::FloatV::WIDTH at a time, with the base at the origin.
+ */
+namespace collision {
+/// @brief Bit flags of what a pose touches.
+enum Contact : std::uint8_t {
+  NONE = 0,
+  GROUND = 1 << 0,
+  BASE = 1 << 1,
+  SELF = 1 << 2,
+  TARGET = 1 << 3,
+};
+
+/// @return Contact flags of one pose, angles in degrees, target center relative to the base.
+std::uint8_t checkPose(float joint0_degree, float joint1_degree, float joint2_degree, const glm::vec3& target);
+/**
+ * @brief Contact flags of count arms.
+ *
+ * All inputs are separate planes of count floats: joint angles in degrees, base positions on the ground and target
+ * centers in world space.
+ */
+void checkBatch(const float* joint0_degree, const float* joint1_degree, const float* joint2_degree,
+                const float* base_x, const float* base_z, const float* target_x, const float* target_y,
+                const float* target_z, std::size_t count, std::uint8_t* contacts);
+}  // namespace collision
@@ -0,0 +1,24 @@
+#pragma once
+#include "utils.h"
+
+#define ANGEL_TO_RADIAN(x) (float)((x)*M_PI / 180.0f)
+#define RADIAN_TO_ANGEL(x) (float)((x)*180.0f / M_PI)
+
+/* Components size definition */
+#define ARM_LEN 1.0f
+#define ARM_RADIUS 0.05f
+#define ARM_DIAMETER (ARM_RADIUS * 2)
+#define JOINT_RADIUS 0.05f
+#define JOINT_DIAMETER (JOINT_RADIUS * 2)
+#define JOINT_WIDTH 0.1f
+#define BASE_RADIUS 0.5f
+#define BASEE_DIAMETER (BASE_RADIUS * 2)
+#define BASE_HEIGHT 0.1f
+#define TARGET_RADIUS 0.05f
+#define TARGET_DIAMETER (TARGET_RADIUS * 2)
+#define TARGET_HEIGHT 0.1f
+#define ROTATE_SPEED 0.3f
+#define CATCH_POSITION_OFFSET 0.1f
+#define TOLERANCE 0.1f
+// Released targets fall this far per simulated second, 0.005 per step at 60 Hz
+#define DROP_SPEED 0.3f
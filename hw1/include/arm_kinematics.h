@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "arm_dimensions.h"
+
+/**
+ * @brief Closed-form kinematics of the three-joint arm with its base at the origin.
+ *
+ * Joint0 yaws around +y, joint1 and joint2 pitch around +x in the plane turned by joint0. With
+ * reach = L2 sin(a1) + L3 sin(a1 + a2), the end effector is (reach sin(a0), H + L2 cos(a1) + L3 cos(a1 + a2),
+ * reach cos(a0)), the same point RobotArm gets from its transform graph. H is JOINT1_HEIGHT, L2 and L3 are the link
+ * lengths. forward() evaluates it through the unrolled ArmChain, forwardBatch() with SIMD.
+ *
+ * Inverse kinematics turn the target into yaw = atan2(x, z), then solve the planar two-link problem for the distance
+ * d from joint1: cos(a2) = (d^2 - L2^2 - L3^2) / (2 L2 L3) and a1 = atan2(reach, y - H) - atan2(L3 sin(a2), L2 + L3
+ * cos(a2)). Both are constant time, no iteration.
+ */
+namespace kinematics {
+/// @brief Height of the joint1 pivot above the ground.
+constexpr float JOINT1_HEIGHT = BASE_HEIGHT + ARM_LEN + JOINT_RADIUS;
+/// @brief Distance from joint1 to joint2.
+constexpr float LINK2_LENGTH = JOINT_RADIUS + ARM_LEN + JOINT_RADIUS;
+/// @brief Distance from joint2 to the catch position.
+constexpr float LINK3_LENGTH = JOINT_RADIUS + ARM_LEN + CATCH_POSITION_OFFSET;
+
+/// @brief Joint angles in degrees that put the end effector on a target.
+struct IkSolution {
+  float joint0, joint1, joint2;
+  /// @brief False if the target is out of reach, the angles then stretch the arm towards it.
+  bool reachable;
+};
+
+/// @brief End effector of a single pose, angles in degrees.
+glm::vec3 forward(float joint0_degree, float joint1_degree, float joint2_degree);
+/**
+ * @brief End effectors of count poses, processed simd::FloatV::WIDTH poses at a time.
+ *
+ * Input and output arrays are separate planes of count floats, angles in degrees.
+ */
+void forwardBatch(const float* joint0_degree, const float* joint1_degree, const float* joint2_degree, std::size_t count,
+                  float* x, float* y, float* z);
+/**
+ * @brief Joint angles for one target relative to the base.
+ *
+ * @param elbow_up Bend joint2 backwards (negative) instead of forwards, the other of the two planar solutions
+ */
+IkSolution inverse(const glm::vec3& target, bool elbow_up = false);
+/**
+ * @brief Joint angles for count targets, processed simd::FloatV::WIDTH targets at a time.
+ *
+ * Targets are relative to the base. reachable receives 1 for reachable targets and 0 otherwise.
+ */
+void inverseBatch(const float* x, const float* y, const float* z, std::size_t count, float* joint0_degree,
+                  float* joint1_degree, float* joint2_degree, std::uint8_t* reachable, bool elbow_up = false);
+}  // namespace kinematics
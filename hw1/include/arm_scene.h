@@ -0,0 +1,135 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "job_system.h"
+#include "robot_arm.h"
+#include "spatial_hash.h"
+
+/**
+ * @brief Many robotic arms on a grid, each with its own target.
+ *
+ * State is kept as structure of arrays: one contiguous array per joint angle and per coordinate, so every update is
+ * a linear pass over a few float arrays. Arm 0 stands at the origin and is driven from outside, the other arms are
+ * animated. End effectors come from the vectorized kinematics::forwardBatch, part matrices are only built for
+ * rendering.
+ *
+ * A grabbing arm catches the nearest free target within TOLERANCE, not only its own, and like a single arm lets go of
+ * it once the tip moved further than TOLERANCE away in one step. Targets are filed in a SpatialHash, so each tip
+ * tests the few targets in its neighbouring cells instead of all of them. After every update
+ * the links of all arms are tested against the board, their base, themselves and their own target in one
+ * collision::checkBatch pass.
+ *
+ * With a JobSystem, animation, forward kinematics and the collision pass are split over its threads. Catching stays
+ * serial, as arms compete for the same targets.
+ */
+class ArmScene {
+ public:
+  /// @brief Distance between neighbouring bases on the grid.
+  static constexpr float GRID_SPACING = 2.5f;
+
+  /// @brief Arms per chunk of the parallel passes.
+  static constexpr std::size_t PARALLEL_GRAIN = 2048;
+
+  /**
+   * @brief The part of the scene rendering reads: bases, joints and targets of the last two steps, and contacts.
+   *
+   * Copying one into another of the same size reuses its storage, so the simulation thread can publish it every step
+   * without allocating. Catch state and the target hash stay in the ArmScene.
+   */
+  class RenderState {
+   public:
+    std::size_t size() const { return joint0.size(); }
+    glm::vec3 getBasePosition(std::size_t arm) const { return glm::vec3(base_x[arm], 0.0f, base_z[arm]); }
+    glm::vec3 getTargetPosition(std::size_t arm) const {
+      return glm::vec3(target_x[arm], target_y[arm], target_z[arm]);
+    }
+    /// @return Target blended from the previous step (alpha 0) to the current one (alpha 1).
+    glm::vec3 getTargetPosition(std::size_t arm, float alpha) const;
+    /// @return collision::Contact flags of the arm after the last update, touching a target it holds does not count.
+    std::uint8_t getContacts(std::size_t arm) const { return contacts[arm]; }
+    /// @return Center of the grid on the ground.
+    glm::vec3 getCenter() const;
+    /// @return Side length of the square covered by the grid, including reach of the outer arms.
+    float getExtent() const;
+    /**
+     * @brief Call add(model, part, arm) for every part of arms [first, last), arm by arm.
+     *
+     * @param add Callable taking (const glm::mat4&, RobotArm::Part, std::size_t)
+     * @param alpha Blend of joint angles from the previous step (0) to the current one (1)
+     */
+    template <typename AddPart>
+    void forEachPart(AddPart&& add, float alpha, std::size_t first, std::size_t last) const {
+      std::array<glm::mat4, RobotArm::PART_COUNT> models;
+      for (std::size_t arm = first; arm < last; ++arm) {
+        computePartModels(arm, alpha, models);
+        for (int part = 0; part < RobotArm::PART_COUNT; ++part) {
+          add(models[part], static_cast<RobotArm::Part>(part), arm);
+        }
+      }
+    }
+
+   private:
+    friend class ArmScene;
+    void computePartModels(std::size_t arm, float alpha, std::array<glm::mat4, RobotArm::PART_COUNT>& models) const;
+
+    std::size_t columns;
+    std::array<glm::mat4, RobotArm::PART_COUNT> part_shapes;
+    std::vector<float> base_x, base_z;
+    std::vector<float> joint0, joint1, joint2;
+    std::vector<float> target_x, target_y, target_z;
+    // State of the previous step, for render interpolation
+    std::vector<float> previous_joint0, previous_joint1, previous_joint2;
+    std::vector<float> previous_target_x, previous_target_y, previous_target_z;
+    std::vector<std::uint8_t> contacts;
+  };
+
+  /// @param count Number of arms, placed row by row starting at the origin.
+  /// @param job_system Runs the per-arm passes in parallel, may be nullptr.
+  explicit ArmScene(std::size_t count, JobSystem* job_system = nullptr);
+  std::size_t size() const { return state.size(); }
+  /// @brief Set joint angles of one arm in degrees.
+  void setJointAngles(std::size_t arm, float joint0_degree, float joint1_degree, float joint2_degree);
+  /// @brief Set catch input of one arm, target i falls while arm i's drop is set and no arm holds it.
+  void setGrip(std::size_t arm, bool grab, bool drop);
+  /// @brief Keep the current joints and targets as the previous state, call before changing them for a new step.
+  void beginStep();
+  /// @brief Move the joints of arms [first, size()) along phase-shifted curves of time in seconds.
+  void animate(double time, std::size_t first = 1);
+  /// @brief Recompute end effectors, then move caught targets and let released ones fall for dt seconds.
+  void update(float dt);
+  const RenderState& getRenderState() const { return state; }
+  glm::vec3 getBasePosition(std::size_t arm) const { return state.getBasePosition(arm); }
+  glm::vec3 getEndEffectorPosition(std::size_t arm) const { return glm::vec3(end_x[arm], end_y[arm], end_z[arm]); }
+  glm::vec3 getTargetPosition(std::size_t arm) const { return state.getTargetPosition(arm); }
+  /// @return collision::Contact flags of the arm after the last update, touching a target it holds does not count.
+  std::uint8_t getContacts(std::size_t arm) const { return state.getContacts(arm); }
+
+ private:
+  static constexpr std::uint32_t NO_TARGET = ~std::uint32_t(0);
+
+  /// @return Nearest target within TOLERANCE of position that no arm holds, or NO_TARGET.
+  std::uint32_t findFreeTarget(const glm::vec3& position) const;
+  /// @brief Call body(begin, end) on chunks covering all arms, in parallel if there is a job system.
+  template <typename Body>
+  void forEachChunk(Body&& body) const {
+    if (jobs) {
+      jobs->parallelFor(size(), PARALLEL_GRAIN, body);
+    } else {
+      body(std::size_t(0), size());
+    }
+  }
+
+  JobSystem* jobs;
+  RenderState state;
+  std::vector<float> end_x, end_y, end_z;
+  std::vector<std::uint8_t> grab, drop;
+  // Target each arm holds or NO_TARGET, and whether each target is held
+  std::vector<std::uint32_t> held;
+  std::vector<std::uint8_t> caught;
+  SpatialHash target_hash;
+};
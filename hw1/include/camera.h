@@ -1,13 +1,27 @@
 #pragma once
+#include <cstdint>
+
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+/// @brief Camera controls of one frame, read from the window or from a recording.
+struct CameraInput {
+  enum Key : std::uint8_t { FORWARD = 1 << 0, BACKWARD = 1 << 1, LEFT = 1 << 2, RIGHT = 1 << 3 };
+  /// @brief Cursor movement since the previous frame, in screen coordinates.
+  glm::vec2 cursorDelta;
+  /// @brief Key bits held down this frame.
+  std::uint8_t keys;
+};
+
 class Camera {
  public:
   Camera(glm::vec3 _position);
   void initialize(float aspectRatio);
-  void move(GLFWwindow* window);
+  /// @brief Read the cursor movement and WASD keys of this frame.
+  CameraInput pollInput(GLFWwindow* window);
+  void move(const CameraInput& input);
+  void move(GLFWwindow* window) { move(pollInput(window)); }
   void updateViewMatrix();
   void updateProjectionMatrix(float aspectRatio);
 
@@ -21,6 +35,9 @@ private:
   glm::vec3 right;
 
   glm::quat rotation;
+  // Cursor position of the previous pollInput, none before the first one
+  glm::dvec2 lastCursor;
+  bool hasCursor = false;
   // TODO (optional): Change these values if your WASD or mouse move too slow or too fast.
   constexpr static float keyboardMoveSpeed = 0.1f;
   constexpr static float mouseMoveSpeed = 0.001f;
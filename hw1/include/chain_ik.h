@@ -0,0 +1,66 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+/// @brief One revolute joint of a serial chain.
+struct JointSpec {
+  /// @brief Translation from the previous pivot to this pivot, in the previous joint's rotated frame.
+  glm::vec3 offset;
+  /// @brief Rotation axis in the frame after the offset.
+  glm::vec3 axis;
+};
+
+/**
+ * @brief Damped least squares inverse kinematics for serial chains of revolute joints.
+ *
+ * Joints follow the transform chain used for the arm: frame_i = frame_(i-1) * translate(offset_i) *
+ * rotate(angle_i, axis_i), and the end effector sits at tip_offset in the last frame. Each iteration solves
+ * d_angles = J^T (J J^T + damping^2 I)^-1 error for the 3 x N position Jacobian, so only a 3 x 3 system is inverted.
+ * All buffers have MAX_JOINTS entries, a solve never allocates.
+ */
+class ChainIk {
+ public:
+  static constexpr std::size_t MAX_JOINTS = 16;
+
+  struct Settings {
+    int max_iterations = 64;
+    /// @brief Distance to the target that counts as reached.
+    float tolerance = 1e-4f;
+    /// @brief Larger values trade convergence speed for stability near singular poses.
+    float damping = 0.05f;
+    /// @brief Error length followed per iteration, longer errors are shortened to it.
+    float max_step = 0.5f;
+  };
+  struct Result {
+    int iterations;
+    /// @brief Distance between end effector and target after the last iteration.
+    float error;
+    bool converged;
+  };
+
+  /// @brief Throws std::length_error if count exceeds MAX_JOINTS.
+  ChainIk(const JointSpec* joints, std::size_t count, const glm::vec3& tip_offset);
+  /// @brief Chain of the robotic arm, the same pivots as RobotArm and kinematics::forward.
+  static ChainIk createArm();
+  std::size_t size() const { return joint_count; }
+  /// @return End effector for angles in degrees.
+  glm::vec3 forward(const float* angles_degree) const;
+  /**
+   * @brief Move the end effector towards target.
+   *
+   * @param angles_degree In: starting pose, pass last frame's solution to warm start. Out: solved pose.
+   */
+  Result solve(const glm::vec3& target, float* angles_degree, const Settings& settings) const;
+  Result solve(const glm::vec3& target, float* angles_degree) const { return solve(target, angles_degree, Settings()); }
+
+ private:
+  /// @brief World pivot and axis of every joint, returns the end effector.
+  glm::vec3 computeFrames(const float* angles_radian, std::array<glm::vec3, MAX_JOINTS>& pivots,
+                          std::array<glm::vec3, MAX_JOINTS>& axes) const;
+
+  std::array<JointSpec, MAX_JOINTS> joints;
+  std::size_t joint_count;
+  glm::vec3 tip;
+};
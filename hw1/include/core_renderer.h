@@ -0,0 +1,53 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+#include "renderer.h"
+#include "shader.h"
+#include "utils.h"
+
+/**
+ * @brief Shader-only renderer for core-profile contexts (OpenGL 3.3 and later).
+ *
+ * Camera and light live in one uniform buffer updated once per frame. Each mesh gets a vertex array object that binds
+ * its vertex and index buffers together with the shared instance buffer, so a draw is one bind and one
+ * glDrawElementsInstanced call. No fixed-function state is touched.
+ */
+class CoreRenderer final : public Renderer {
+ public:
+  CoreRenderer();
+  // Not copyable
+  DELETE_COPY(CoreRenderer)
+  // Not movable
+  DELETE_MOVE(CoreRenderer)
+  /// @brief Release vertex arrays and buffers
+  ~CoreRenderer() override;
+  /// @brief Upload camera and light data to the uniform buffer.
+  void beginFrame(const glm::mat4& view, const glm::mat4& projection, const Light& light, bool lighting) override;
+  void draw(const Mesh& mesh, const std::vector<Instance>& instances) override;
+
+ private:
+  /// @brief std140 layout of the Frame uniform block.
+  struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    // Light position is transformed to view space on CPU
+    glm::vec4 light_position;
+    glm::vec4 light_ambient;
+    glm::vec4 light_diffuse;
+    glm::vec4 global_ambient;
+    GLint lighting;
+    GLint padding[3];
+  };
+  /// @return Vertex array of the mesh, created on first use.
+  GLuint getVertexArray(const Mesh& mesh);
+  ShaderProgram program;
+  GLuint uniform_buffer = 0;
+  GLuint instance_buffer = 0;
+  GLsizeiptr instance_buffer_size = 0;
+  std::unordered_map<GLuint, GLuint> vertex_arrays;
+};
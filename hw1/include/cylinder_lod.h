@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+#include "utils.h"
+
+/**
+ * @brief Unit cylinder meshes at several tessellation levels, picked per part by screen-space size.
+ *
+ * The level is the coarsest one whose polygonal silhouette stays within MAX_ERROR_PIXELS of the true circle after
+ * projection, so far or small parts cost a handful of triangles while close-ups keep the full CIRCLE_SEGMENT ring.
+ */
+class CylinderLod final {
+ public:
+  /// @brief Segment count of every level, from coarse to fine.
+  static constexpr std::array<int, 4> SEGMENTS{8, 16, 32, 64};
+  static constexpr std::size_t LEVEL_COUNT = SEGMENTS.size();
+  /// @brief Allowed distance in pixels between the projected circle and its polygon.
+  static constexpr float MAX_ERROR_PIXELS = 0.5f;
+
+  CylinderLod() : meshes(createMeshes(std::make_index_sequence<LEVEL_COUNT>())) {}
+  // Not copyable
+  DELETE_COPY(CylinderLod)
+  // Not movable
+  DELETE_MOVE(CylinderLod)
+
+  /**
+   * @brief Update the camera used for level selection, call once per frame.
+   *
+   * @param view View matrix
+   * @param projection Perspective projection matrix
+   * @param viewport_height Framebuffer height in pixels
+   */
+  void setCamera(const glm::mat4& view, const glm::mat4& projection, int viewport_height);
+  /**
+   * @brief Select a level for a part.
+   *
+   * @param model Model matrix that maps the unit cylinder to the part
+   * @return Index of the level to draw, use getMesh to fetch it.
+   */
+  std::size_t selectLevel(const glm::mat4& model) const;
+  const Mesh& getMesh(std::size_t level) const { return meshes[level]; }
+
+ private:
+  template <std::size_t... Level>
+  static std::array<Mesh, LEVEL_COUNT> createMeshes(std::index_sequence<Level...>) {
+    return {Mesh::createUnitCylinder<SEGMENTS[Level]>()...};
+  }
+  std::array<Mesh, LEVEL_COUNT> meshes;
+  glm::mat4 view_matrix{1.0f};
+  // Pixels covered by one world unit at distance 1 from the camera
+  float pixels_per_unit = 1.0f;
+};
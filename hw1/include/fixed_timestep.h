@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Accumulator that turns variable frame times into fixed simulation steps.
+ *
+ * Each frame adds the elapsed wall time and runs as many whole steps as fit. The remainder, as a fraction of a step,
+ * tells the renderer how far to interpolate between the last two simulated states. If a frame would need more than
+ * max_steps steps, the extra time is dropped so a slow frame cannot snowball into ever longer catch-up.
+ */
+class FixedTimestep {
+ public:
+  /// @param step_seconds Simulated seconds per step
+  /// @param max_steps_per_frame Most steps run in one frame
+  explicit FixedTimestep(double step_seconds, int max_steps_per_frame = 8);
+  /// @return Number of steps to simulate for a frame that starts at now (seconds), 0 on the first call.
+  int advance(double now);
+  double getStep() const { return step; }
+  /// @return Simulated seconds after the steps returned so far.
+  double getTime() const { return time; }
+  /// @return Blend factor in [0, 1) from the previous to the latest simulated state.
+  float getAlpha() const { return static_cast<float>(accumulator / step); }
+  /// @return Wall time discarded because of the catch-up cap.
+  double getDroppedTime() const { return dropped; }
+
+ private:
+  double step;
+  int max_steps;
+  double last = -1.0;
+  double accumulator = 0.0;
+  double time = 0.0;
+  double dropped = 0.0;
+};
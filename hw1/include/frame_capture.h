@@ -0,0 +1,68 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "utils.h"
+
+/**
+ * @brief Write rendered frames to PPM files without stalling the render loop.
+ *
+ * Every frame is read into one of RING_SIZE pixel buffer objects, which the GPU fills asynchronously. A buffer is
+ * mapped only when the ring wraps around to it, RING_SIZE frames later, so the copy has long finished by then.
+ * Encoding and file output run on a writer thread.
+ */
+class FrameCapture final {
+ public:
+  /// @brief Frames in flight between glReadPixels and mapping.
+  static constexpr int RING_SIZE = 3;
+  /// @brief Frames queued for the writer thread before capture waits for it.
+  static constexpr std::size_t MAX_PENDING_FRAMES = 8;
+
+  /// @brief Create PBOs and start the writer thread, output_directory is created if missing.
+  explicit FrameCapture(const std::filesystem::path& output_directory);
+  // Not copyable
+  DELETE_COPY(FrameCapture)
+  // Not movable
+  DELETE_MOVE(FrameCapture)
+  /// @brief Write frames still in flight, then join the writer thread. The context must still be current.
+  ~FrameCapture();
+  /// @brief Queue a readback of the back buffer, call right before glfwSwapBuffers.
+  void capture(int width, int height);
+
+ private:
+  struct Slot {
+    GLuint buffer = 0;
+    int width = 0, height = 0;
+    std::uint64_t frame = 0;
+    bool pending = false;
+  };
+  struct Frame {
+    std::uint64_t index;
+    int width, height;
+    std::vector<unsigned char> pixels;
+  };
+  /// @brief Map a finished slot and hand its pixels to the writer thread.
+  void drain(Slot& slot);
+  void writerLoop();
+  void writeFrame(const Frame& frame) const;
+
+  std::filesystem::path directory;
+  Slot slots[RING_SIZE];
+  int next_slot = 0;
+  std::uint64_t frame_index = 0;
+
+  std::mutex mutex;
+  std::condition_variable frame_ready, frame_written;
+  std::deque<Frame> queue;
+  // Pixel storage recycled from written frames
+  std::vector<std::vector<unsigned char>> free_buffers;
+  bool stopping = false;
+  std::thread writer;
+};
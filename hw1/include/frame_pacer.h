@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+
+/// @brief Swap interval policy.
+enum class VsyncMode {
+  /// @brief Swap immediately, may tear.
+  OFF,
+  /// @brief Wait for vertical blank.
+  ON,
+  /// @brief Wait for vertical blank unless the frame is late, then swap immediately.
+  ADAPTIVE
+};
+
+/**
+ * @brief Apply a vsync mode and limit the frame rate.
+ *
+ * The limiter keeps a deadline that advances by one period per frame. It sleeps until shortly before the deadline,
+ * since sleep can overshoot by a scheduler tick, and spins on glfwGetTime for the rest. Frame times are accumulated so
+ * the achieved jitter can be reported.
+ */
+class FramePacer final {
+ public:
+  /// @brief Frame time statistics in milliseconds.
+  struct Stats {
+    std::uint64_t frames = 0;
+    double mean = 0.0;
+    /// @brief Standard deviation of the frame time.
+    double jitter = 0.0;
+    double max = 0.0;
+  };
+  /// @brief Time left before a deadline that is spent spinning instead of sleeping, in seconds.
+  static constexpr double SPIN_THRESHOLD = 0.002;
+
+  /// @param target_fps Frame rate cap, 0 disables the limiter.
+  explicit FramePacer(double target_fps = 0.0);
+  /**
+   * @brief Set swap interval of the current context.
+   *
+   * Adaptive vsync needs the swap_control_tear extension and falls back to ON without it.
+   * @return Mode actually applied.
+   */
+  static VsyncMode applyVsync(VsyncMode mode);
+  /// @brief Wait for the next frame deadline and record the frame time, call after glfwSwapBuffers.
+  void endFrame();
+  const Stats& getStats() const { return stats; }
+
+ private:
+  double period;
+  double deadline = -1.0;
+  double last_frame_end = -1.0;
+  Stats stats;
+  // Running sum of squared differences from the mean, in ms^2
+  double squared_deviation = 0.0;
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+
+#include "utils.h"
+
+/// @brief Interleaved vertex layout shared by every mesh.
+struct Vertex {
+  glm::vec3 position;
+  glm::vec3 normal;
+};
+
+namespace geometry {
+/// @return Unit circle sampled at Segments + 1 points as (sin, cos), the last point repeats the first one exactly.
+template <int Segments>
+constexpr std::array<glm::vec2, Segments + 1> generateRing() {
+  std::array<glm::vec2, Segments + 1> ring{};
+  for (int i = 0; i <= Segments; ++i) {
+    double radian = 2 * M_PI * (i % Segments) / Segments;
+    ring[i] = glm::vec2(static_cast<float>(utils::constexprSin(radian)),
+                        static_cast<float>(utils::constexprCos(radian)));
+  }
+  return ring;
+}
+
+template <int Segments>
+constexpr std::array<Vertex, 4 * (Segments + 1) + 2> generateCylinderVertices() {
+  constexpr auto ring = generateRing<Segments>();
+  std::array<Vertex, 4 * (Segments + 1) + 2> vertices{};
+  std::size_t n = 0;
+  // Side: a pair of (bottom, top) vertices per ring position, the seam is duplicated.
+  for (const auto& point : ring) {
+    glm::vec3 normal(point.x, 0.0f, point.y);
+    vertices[n++] = Vertex{glm::vec3(point.x, 0.0f, point.y), normal};
+    vertices[n++] = Vertex{glm::vec3(point.x, 1.0f, point.y), normal};
+  }
+  // Caps: center vertex followed by the ring, with flat normals. Top cap first.
+  for (float y : {1.0f, 0.0f}) {
+    glm::vec3 normal(0.0f, y * 2.0f - 1.0f, 0.0f);
+    vertices[n++] = Vertex{glm::vec3(0.0f, y, 0.0f), normal};
+    for (const auto& point : ring) {
+      vertices[n++] = Vertex{glm::vec3(point.x, y, point.y), normal};
+    }
+  }
+  return vertices;
+}
+
+template <int Segments>
+constexpr std::array<GLuint, 12 * Segments> generateCylinderIndices() {
+  std::array<GLuint, 12 * Segments> indices{};
+  std::size_t n = 0;
+  for (GLuint i = 0; i < Segments; ++i) {
+    GLuint bottom = 2 * i, top = 2 * i + 1, next_bottom = 2 * i + 2, next_top = 2 * i + 3;
+    for (GLuint index : {bottom, next_bottom, next_top, bottom, next_top, top}) indices[n++] = index;
+  }
+  // Keep counter-clockwise winding when looking at the caps from outside.
+  constexpr GLuint top_center = 2 * (Segments + 1);
+  constexpr GLuint bottom_center = top_center + Segments + 2;
+  for (GLuint i = 0; i < Segments; ++i) {
+    for (GLuint index : {top_center, top_center + 1 + i, top_center + 2 + i}) indices[n++] = index;
+  }
+  for (GLuint i = 0; i < Segments; ++i) {
+    for (GLuint index : {bottom_center, bottom_center + 2 + i, bottom_center + 1 + i}) indices[n++] = index;
+  }
+  return indices;
+}
+}  // namespace geometry
+
+/**
+ * @brief Unit cylinder along +y axis generated at compile time.
+ *
+ * Radius is 1, bottom cap at y = 0 and top cap at y = 1. Both tables are embedded as static data, so building a
+ * cylinder mesh costs no trigonometry at runtime.
+ *
+ * @tparam Segments Number of segments around the circle.
+ */
+template <int Segments>
+struct CylinderGeometry {
+  static_assert(Segments >= 3, "A cylinder needs at least 3 segments");
+  static constexpr std::array<Vertex, 4 * (Segments + 1) + 2> vertices =
+      geometry::generateCylinderVertices<Segments>();
+  static constexpr std::array<GLuint, 12 * Segments> indices = geometry::generateCylinderIndices<Segments>();
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+
+#include "utils.h"
+
+/**
+ * @brief Shadow copy of the OpenGL state that is changed every frame.
+ *
+ * Each setter forwards to OpenGL only when the value differs from the last one set through this class, so redundant
+ * calls never reach the driver. State is unknown until first set, and every state change should go through here once
+ * the cache is used, otherwise call invalidate().
+ */
+class GLState final {
+ public:
+  /// @brief Number of state calls forwarded to and dropped before reaching OpenGL.
+  struct Stats {
+    std::uint64_t issued = 0;
+    std::uint64_t elided = 0;
+  };
+  // Only static members
+  GLState() = delete;
+
+  static void enable(GLenum capability) { setCapability(capability, true); }
+  static void disable(GLenum capability) { setCapability(capability, false); }
+  static void depthFunc(GLenum function);
+  static void clearColor(const glm::vec4& color);
+  static void clearDepth(GLdouble depth);
+  static void shadeModel(GLenum mode);
+  static void colorMaterial(GLenum face, GLenum mode);
+  /// @brief GL_POSITION and GL_SPOT_DIRECTION are always forwarded since they depend on the modelview matrix.
+  static void lightfv(GLenum light, GLenum name, const glm::vec4& value);
+  static void useProgram(GLuint handle);
+  static void bindVertexArray(GLuint handle);
+
+  /// @brief Forget everything, use after OpenGL state was changed behind this class.
+  static void invalidate();
+  /// @brief Start counting a new frame, returns counters of the previous one.
+  static Stats newFrame();
+  /// @return Counters of the current frame so far.
+  static const Stats& getFrameStats() { return frame_stats; }
+  /// @return Counters since program start.
+  static const Stats& getTotalStats() { return total_stats; }
+
+ private:
+  static void setCapability(GLenum capability, bool enabled);
+  /// @return True if the call should be forwarded, and update counters.
+  template <typename T, typename U>
+  static bool update(std::optional<T>& shadow, const U& value) {
+    if (shadow.has_value() && *shadow == value) {
+      ++frame_stats.elided;
+      ++total_stats.elided;
+      return false;
+    }
+    shadow = value;
+    ++frame_stats.issued;
+    ++total_stats.issued;
+    return true;
+  }
+  static std::unordered_map<GLenum, std::optional<bool>> capabilities;
+  static std::unordered_map<std::uint32_t, std::optional<glm::vec4>> light_parameters;
+  static std::optional<GLenum> depth_function;
+  static std::optional<glm::vec4> clear_color;
+  static std::optional<GLdouble> clear_depth;
+  static std::optional<GLenum> shade_model;
+  static std::optional<glm::uvec2> color_material;
+  static std::optional<GLuint> program;
+  static std::optional<GLuint> vertex_array;
+  static Stats frame_stats;
+  static Stats total_stats;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "motion_planner.h"
+#include "spsc_queue.h"
+
+/// @brief One keyboard action for arm 0, stamped when the window system delivered it.
+struct InputEvent {
+  using Clock = std::chrono::steady_clock;
+  enum class Type : std::uint8_t { ROTATE, GRAB, RELEASE, TOGGLE_DROP, REACH, PLAN };
+
+  Type type;
+  /// @brief Joint index and angle in degrees, only used by ROTATE.
+  std::uint8_t joint;
+  float degrees;
+  Clock::time_point time;
+};
+
+/// @brief Events from the window callbacks to whichever thread runs the simulation.
+using InputQueue = SpscQueue<InputEvent, 256>;
+
+/// @brief Delay between an event being stamped and the simulation applying it.
+struct InputLatency {
+  std::uint64_t events = 0;
+  double total_ms = 0.0;
+  double max_ms = 0.0;
+
+  void add(InputEvent::Clock::time_point event, InputEvent::Clock::time_point now);
+  double getMean() const { return events > 0 ? total_ms / static_cast<double>(events) : 0.0; }
+};
+
+/// @brief Input state of arm 0, only ever changed by applying events in order and following planned paths.
+struct ArmControl {
+  /// @brief Joint speed along a planned path, in degrees per second.
+  static constexpr float PATH_SPEED = 90.0f;
+
+  glm::vec3 joints{0.0f};
+  bool grab = false;
+  bool drop = false;
+  /// @brief Plans paths for PLAN events, which are ignored without one.
+  MotionPlanner* planner = nullptr;
+  /// @brief Waypoints still to visit, any manual move cancels them.
+  std::vector<glm::vec3> path;
+  std::size_t next_waypoint = 0;
+
+  /// @brief Apply one event, REACH snaps onto target and PLAN plans a collision-free path to it.
+  void apply(const InputEvent& event, const glm::vec3& target);
+  /// @brief Apply every queued event, call once per simulation step from the consumer thread.
+  void drain(InputQueue& queue, const glm::vec3& target, InputLatency& latency);
+  /// @brief Move the joints dt seconds further along the planned path.
+  void follow(float dt);
+};
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "camera.h"
+#include "utils.h"
+
+/**
+ * @brief Binary log of everything a run reads from the window: key callbacks and camera input, frame by frame.
+ *
+ * The file starts with a Header, then holds one record per frame: the frame time (f64, seconds since the first
+ * frame), the camera cursor delta (2 x f32), the camera key bits (u8) and the number of key callbacks (u16), followed
+ * by that many (key i16, action u8) pairs. Values are stored in native byte order. Replaying feeds the keys back
+ * through the key callback and drives the fixed timestep with the logged frame times instead of the clock, so the
+ * simulation takes exactly the same steps no matter how fast the replay renders.
+ */
+namespace input_log {
+/// @brief Settings that change what the simulation does with the same input, taken over by the replay.
+struct Header {
+  char magic[4];
+  std::uint32_t version;
+  std::uint32_t arms;
+  double sim_rate;
+};
+
+/// @brief One key callback.
+struct KeyAction {
+  std::int16_t key;
+  std::uint8_t action;
+};
+
+/// @brief Input of one frame.
+struct Frame {
+  double time;
+  CameraInput camera;
+  std::vector<KeyAction> keys;
+};
+
+/// @brief Create a header for the current file version.
+Header makeHeader(int arms, double sim_rate);
+
+class Recorder final {
+ public:
+  /// @brief Create or truncate path and write the header, throws std::runtime_error if that fails.
+  Recorder(const std::filesystem::path& path, const Header& header);
+  // Not copyable
+  DELETE_COPY(Recorder)
+  // Not movable
+  DELETE_MOVE(Recorder)
+  /// @brief Add a key callback to the frame being recorded.
+  void recordKey(int key, int action);
+  /// @brief Write the frame with the keys recorded since the last one.
+  void writeFrame(double time, const CameraInput& camera);
+
+ private:
+  std::ofstream file;
+  std::vector<KeyAction> keys;
+  std::vector<char> buffer;
+};
+
+class Player final {
+ public:
+  /**
+   * @brief Open a log and read its header.
+   *
+   * Throws std::runtime_error if it is not a log of this version or its arm count or simulation rate is invalid.
+   */
+  explicit Player(const std::filesystem::path& path);
+  // Not copyable
+  DELETE_COPY(Player)
+  // Not movable
+  DELETE_MOVE(Player)
+  const Header& getHeader() const { return header; }
+  /// @brief Read the next frame. Returns false at the end of the log, throws std::runtime_error if it is truncated.
+  bool next(Frame& frame);
+
+ private:
+  std::ifstream file;
+  Header header;
+};
+}  // namespace input_log
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+#include "renderer.h"
+#include "shader.h"
+#include "utils.h"
+
+/**
+ * @brief Draw every instance of a mesh with a single glDrawElementsInstanced call.
+ *
+ * Instance matrices and colors are streamed into one buffer per frame and read by a GLSL 1.20 shader through
+ * instanced vertex attributes. The shader reproduces the fixed-function GL_LIGHT0 setup, so it can be mixed with the
+ * legacy pipeline. If the context lacks instanced arrays, every instance is drawn separately instead.
+ */
+class InstancedRenderer final : public Renderer {
+ public:
+  InstancedRenderer();
+  // Not copyable
+  DELETE_COPY(InstancedRenderer)
+  // Not movable
+  DELETE_MOVE(InstancedRenderer)
+  /// @brief Release instance buffer
+  ~InstancedRenderer() override;
+  /// @return True if current context can draw instanced arrays.
+  static bool isSupported();
+  /// @brief Load camera matrices and configure GL_LIGHT0.
+  void beginFrame(const glm::mat4& view, const glm::mat4& projection, const Light& light, bool lighting) override;
+  void draw(const Mesh& mesh, const std::vector<Instance>& instances) override;
+
+ private:
+  void drawFallback(const Mesh& mesh, const std::vector<Instance>& instances) const;
+  bool supported;
+  ShaderProgram program;
+  GLint lighting_location = -1;
+  bool lighting_enabled = true;
+  GLuint instance_buffer = 0;
+  GLsizeiptr instance_buffer_size = 0;
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "utils.h"
+
+/**
+ * @brief Tasks that run once per TaskGraph run, each after all of its dependencies finished.
+ *
+ * Build the graph once and run it every frame, bodies usually capture the frame's state by reference.
+ */
+class TaskGraph final {
+ public:
+  using TaskId = std::size_t;
+
+  /// @brief Add a task that starts once every task in dependencies finished, which must have been added before.
+  TaskId add(std::function<void()> body, std::initializer_list<TaskId> dependencies = {});
+  std::size_t size() const { return tasks.size(); }
+
+ private:
+  friend class JobSystem;
+  struct Task {
+    std::function<void()> body;
+    std::vector<TaskId> successors;
+    std::size_t dependency_count = 0;
+    // Dependencies of the current run that have not finished yet
+    std::atomic<std::size_t> waiting{0};
+  };
+  // Tasks never move, a deque keeps their atomics in place while adding
+  std::deque<Task> tasks;
+};
+
+/**
+ * @brief Work-stealing scheduler: worker threads with one job deque each, plus one shared by outside threads.
+ *
+ * A thread pushes and pops jobs at the back of its own deque, so it keeps working on what it split off last while
+ * that is still in cache. Threads that run dry steal from the front of the others, which holds the oldest and
+ * largest pieces of work. Threads waiting for jobs they submitted run jobs too, so parallelFor and run may be called
+ * from inside jobs and from several outside threads at once. A waiting worker runs any job, a waiting outside thread
+ * only the ones it is waiting for, so a thread with its own pace (the render loop, the simulation thread) never ends
+ * up doing another one's work. Jobs are small values in the deques, submitting one does not allocate once the deques
+ * have grown.
+ */
+class JobSystem final {
+ public:
+  /// @param worker_count Threads besides the callers, 0 runs everything on the calling thread.
+  explicit JobSystem(unsigned worker_count);
+  // Not copyable
+  DELETE_COPY(JobSystem)
+  // Not movable
+  DELETE_MOVE(JobSystem)
+  /// @brief Join all workers, no job may still be running.
+  ~JobSystem();
+  /// @return Threads that take part in the work, including the caller.
+  std::size_t size() const { return workers.size() + 1; }
+  /**
+   * @brief Call body(begin, end) for consecutive chunks covering [0, count), in parallel.
+   *
+   * The range is split in halves on demand, one half is run and the other left for thieves, until chunks are no
+   * longer than grain.
+   *
+   * @param grain Longest chunk given to one call of body
+   */
+  template <typename Body>
+  void parallelFor(std::size_t count, std::size_t grain, Body&& body) {
+    if (count == 0) return;
+    if (workers.empty() || count <= grain) {
+      body(std::size_t(0), count);
+      return;
+    }
+    submitAndWait(Job{[](void* context, std::size_t begin, std::size_t end) {
+                        (*static_cast<std::remove_reference_t<Body>*>(context))(begin, end);
+                      },
+                      &body, 0, count, std::max<std::size_t>(grain, 1), nullptr});
+  }
+  /// @brief Run every task of graph, in dependency order, and return once all of them finished.
+  void run(TaskGraph& graph);
+
+ private:
+  using Invoke = void (*)(void*, std::size_t, std::size_t);
+  /// @brief Jobs of one parallelFor or run that have not finished.
+  struct Counter {
+    std::atomic<std::size_t> pending{0};
+  };
+  struct Job {
+    Invoke invoke;
+    void* context;
+    std::size_t begin, end;
+    /// @brief Split while longer than this, ranges of graph tasks are never split.
+    std::size_t grain;
+    Counter* counter;
+  };
+  struct alignas(64) Queue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+  struct GraphRun;
+  static constexpr std::size_t NO_SPLIT = std::numeric_limits<std::size_t>::max();
+
+  /// @brief Run job and everything it splits into, then return once all of it finished.
+  void submitAndWait(Job job);
+  /// @brief Queue a job on the calling thread's deque and wake a sleeping worker.
+  void push(const Job& job);
+  /**
+   * @brief Take a job from the calling thread's deque or steal one. Returns false if there was none.
+   *
+   * @param only Take only jobs of this counter, nullptr takes any
+   */
+  bool tryTake(Job& job, const Counter* only);
+  /// @brief Run job, splitting off halves into the calling thread's deque while it is longer than its grain.
+  void execute(Job job);
+  /// @brief Run jobs until counter drops to zero, outside threads only run jobs of counter.
+  void waitFor(const Counter& counter);
+  static void runTask(void* context, std::size_t task, std::size_t);
+  void workerLoop(std::size_t queue);
+  /// @return Deque of the calling thread, the shared one for threads that are not workers.
+  std::size_t getLocalQueue() const;
+
+  // queues[0] is shared by outside threads, queues[i + 1] belongs to workers[i]
+  std::unique_ptr<Queue[]> queues;
+  std::size_t queue_count;
+  std::vector<std::thread> workers;
+  // Workers sleep on wake while nothing is queued, epoch changes whenever a job is pushed
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+  std::atomic<std::uint64_t> epoch{0};
+  std::atomic<unsigned> sleeping{0};
+  bool stopping = false;
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+#include "arm_dimensions.h"
+#include "chain_ik.h"
+
+/// @brief Rotation axis of a chain element, NONE marks a fixed link that consumes no angle.
+enum class ChainAxis { NONE, X, Y, Z };
+
+/**
+ * @brief One element of a KinematicChain: translate by Offset, then rotate around JointAxis.
+ *
+ * Offset is a type with static constexpr float members x, y and z, so the chain stays usable as C++17.
+ */
+template <ChainAxis JointAxis, typename Offset>
+struct ChainJoint {
+  static constexpr ChainAxis axis = JointAxis;
+  static constexpr float x = Offset::x, y = Offset::y, z = Offset::z;
+};
+
+/**
+ * @brief Serial chain whose axes and offsets are template parameters.
+ *
+ * forward() is unrolled into straight-line code: the end point is carried from the last element back to the root,
+ * each step a constant translation and a rotation around a fixed axis. Zero offsets and unused rotation terms fold
+ * away at compile time. Chains only known at runtime use ChainIk, which makeRuntime() builds from the same elements.
+ *
+ * @tparam Joints ChainJoint types from the root outwards, a trailing fixed link is the end effector.
+ */
+template <typename... Joints>
+class KinematicChain {
+ public:
+  static constexpr std::size_t ELEMENT_COUNT = sizeof...(Joints);
+  /// @brief Number of angles forward() reads.
+  static constexpr std::size_t JOINT_COUNT = ((Joints::axis != ChainAxis::NONE ? 1 : 0) + ... + 0);
+
+  /// @return End effector for angles in degrees, one per rotating joint.
+  static glm::vec3 forward(const float* angles_degree) {
+    return forwardFrom(angles_degree, std::make_index_sequence<ELEMENT_COUNT>());
+  }
+  /// @return The same chain for the runtime solver, fixed links are merged into their neighbours.
+  static ChainIk makeRuntime() {
+    std::array<JointSpec, JOINT_COUNT> specs{};
+    std::size_t count = 0;
+    glm::vec3 pending(0.0f);
+    auto append = [&](ChainAxis axis, const glm::vec3& offset) {
+      pending += offset;
+      if (axis == ChainAxis::NONE) return;
+      specs[count++] = JointSpec{pending, axisVector(axis)};
+      pending = glm::vec3(0.0f);
+    };
+    (append(Joints::axis, glm::vec3(Joints::x, Joints::y, Joints::z)), ...);
+    return ChainIk(specs.data(), count, pending);
+  }
+
+ private:
+  using Elements = std::tuple<Joints...>;
+
+  static constexpr glm::vec3 axisVector(ChainAxis axis) {
+    return axis == ChainAxis::X ? glm::vec3(1.0f, 0.0f, 0.0f)
+                                : axis == ChainAxis::Y ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+  }
+  /// @return Index into the angle array of element I.
+  template <std::size_t I>
+  static constexpr std::size_t angleIndex() {
+    std::size_t index = 0;
+    constexpr ChainAxis axes[] = {Joints::axis...};
+    for (std::size_t i = 0; i < I; ++i) index += axes[i] != ChainAxis::NONE ? 1 : 0;
+    return index;
+  }
+  /// @brief Map point p from the frame after element I into the frame before it.
+  template <std::size_t I>
+  static glm::vec3 step(const glm::vec3& p, const float* angles_degree) {
+    using Joint = std::tuple_element_t<I, Elements>;
+    glm::vec3 rotated = p;
+    if constexpr (Joint::axis != ChainAxis::NONE) {
+      const float angle = glm::radians(angles_degree[angleIndex<I>()]);
+      const float c = std::cos(angle), s = std::sin(angle);
+      if constexpr (Joint::axis == ChainAxis::X) {
+        rotated = glm::vec3(p.x, c * p.y - s * p.z, s * p.y + c * p.z);
+      } else if constexpr (Joint::axis == ChainAxis::Y) {
+        rotated = glm::vec3(c * p.x + s * p.z, p.y, c * p.z - s * p.x);
+      } else {
+        rotated = glm::vec3(c * p.x - s * p.y, s * p.x + c * p.y, p.z);
+      }
+    }
+    return rotated + glm::vec3(Joint::x, Joint::y, Joint::z);
+  }
+  template <std::size_t... I>
+  static glm::vec3 forwardFrom(const float* angles_degree, std::index_sequence<I...>) {
+    glm::vec3 p(0.0f);
+    // Left fold over ascending I visits the elements from the last to the root
+    ((p = step<ELEMENT_COUNT - 1 - I>(p, angles_degree)), ...);
+    return p;
+  }
+};
+
+/// @brief Offsets of the robotic arm, see RobotArm for the same pivots as a transform graph.
+namespace arm_chain {
+struct BaseTop {
+  static constexpr float x = 0.0f, y = BASE_HEIGHT, z = 0.0f;
+};
+struct Joint1 {
+  static constexpr float x = 0.0f, y = ARM_LEN + JOINT_RADIUS, z = 0.0f;
+};
+struct Joint2 {
+  static constexpr float x = 0.0f, y = JOINT_RADIUS + ARM_LEN + JOINT_RADIUS, z = 0.0f;
+};
+struct Tip {
+  static constexpr float x = 0.0f, y = JOINT_RADIUS + ARM_LEN + CATCH_POSITION_OFFSET, z = 0.0f;
+};
+}  // namespace arm_chain
+
+/// @brief The robotic arm: yaw on the base, then two pitch joints and the catch position.
+using ArmChain =
+    KinematicChain<ChainJoint<ChainAxis::Y, arm_chain::BaseTop>, ChainJoint<ChainAxis::X, arm_chain::Joint1>,
+                   ChainJoint<ChainAxis::X, arm_chain::Joint2>, ChainJoint<ChainAxis::NONE, arm_chain::Tip>>;
@@ -0,0 +1,75 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "cylinder_lod.h"
+#include "job_system.h"
+#include "renderer.h"
+
+/**
+ * @brief Cylinder instances of one frame, one list per CylinderLod level, built on all threads of a JobSystem.
+ *
+ * Items are cut into a fixed number of chunks that each fill their own lists, so no thread waits for another and the
+ * order within a level is the item order regardless of which thread built what. The chunk lists are then copied
+ * into one list per level, also in parallel. All lists keep their capacity between frames.
+ */
+class LodInstances final {
+ public:
+  /// @brief Chunks per thread, more even out items that take longer than others.
+  static constexpr std::size_t CHUNKS_PER_THREAD = 4;
+  /// @brief Fewest items worth a chunk of their own.
+  static constexpr std::size_t MIN_CHUNK_ITEMS = 256;
+
+  /// @brief Receives the cylinders of one chunk.
+  class Sink {
+   public:
+    /// @brief Add a unit cylinder placed by model, at the level lod picks for it.
+    void add(const glm::mat4& model, const glm::vec3& color) {
+      lists[lod.selectLevel(model)].push_back(Instance::create(model, color));
+    }
+
+   private:
+    friend class LodInstances;
+    Sink(const CylinderLod& cylinder_lod, std::array<std::vector<Instance>, CylinderLod::LEVEL_COUNT>& chunk_lists)
+        : lod(cylinder_lod), lists(chunk_lists) {}
+    const CylinderLod& lod;
+    std::array<std::vector<Instance>, CylinderLod::LEVEL_COUNT>& lists;
+  };
+
+  explicit LodInstances(const CylinderLod& cylinder_lod) : lod(cylinder_lod) {}
+  /**
+   * @brief Replace the lists by the cylinders of items [0, count).
+   *
+   * @param build Callable taking (std::size_t begin, std::size_t end, Sink&), adds the cylinders of items [begin, end)
+   */
+  template <typename Build>
+  void build(JobSystem& jobs, std::size_t count, Build&& build) {
+    const std::size_t chunk_count = getChunkCount(jobs, count);
+    if (chunks.size() < chunk_count) chunks.resize(chunk_count);
+    jobs.parallelFor(chunk_count, 1, [&](std::size_t first, std::size_t last) {
+      for (std::size_t chunk = first; chunk < last; ++chunk) {
+        for (std::vector<Instance>& list : chunks[chunk]) list.clear();
+        Sink sink(lod, chunks[chunk]);
+        build(chunk * count / chunk_count, (chunk + 1) * count / chunk_count, sink);
+      }
+    });
+    merge(jobs, chunk_count);
+  }
+  const std::vector<Instance>& get(std::size_t level) const { return lists[level]; }
+
+ private:
+  using Lists = std::array<std::vector<Instance>, CylinderLod::LEVEL_COUNT>;
+
+  static std::size_t getChunkCount(const JobSystem& jobs, std::size_t count);
+  /// @brief Concatenate the first chunk_count chunks into lists.
+  void merge(JobSystem& jobs, std::size_t chunk_count);
+
+  const CylinderLod& lod;
+  std::vector<Lists> chunks;
+  Lists lists;
+  // Start of each chunk in the lists of every level
+  std::vector<std::array<std::size_t, CylinderLod::LEVEL_COUNT>> offsets;
+};
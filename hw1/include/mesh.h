@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+
+#include "geometry.h"
+#include "utils.h"
+
+/**
+ * @brief Retained-mode triangle mesh stored in GPU buffers.
+ *
+ * Geometry is uploaded once into a vertex buffer and an index buffer, and the mesh holds only that geometry. Model
+ * matrix and color come from the Renderer: one Instance per part is streamed into an instance buffer and read as
+ * instanced vertex attributes, so one mesh is shared by all parts of its shape and drawn with a single call. Only the
+ * fallback without instanced arrays draws instance by instance with the modelview matrix and glColor.
+ */
+class Mesh final {
+ public:
+  Mesh() = default;
+  Mesh(const Vertex* vertices, std::size_t num_vertices, const GLuint* indices, std::size_t num_indices);
+  Mesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices)
+      : Mesh(vertices.data(), vertices.size(), indices.data(), indices.size()) {}
+  // Not copyable
+  DELETE_COPY(Mesh)
+  Mesh(Mesh&& other) noexcept;
+  Mesh& operator=(Mesh&& other) noexcept;
+  /// @brief Release GPU buffers
+  ~Mesh();
+  /**
+   * @brief Create a unit cylinder along +y axis from compile-time generated tables.
+   *
+   * @tparam Segments Number of segments around the circle.
+   * @return Cylinder with radius 1, bottom cap at y = 0 and top cap at y = 1.
+   */
+  template <int Segments>
+  static Mesh createUnitCylinder() {
+    using Geometry = CylinderGeometry<Segments>;
+    return Mesh(Geometry::vertices.data(), Geometry::vertices.size(), Geometry::indices.data(),
+                Geometry::indices.size());
+  }
+  /// @return Plane on y = 0 spanning [-1, 1] on both x and z axis, facing +y.
+  static Mesh createUnitPlane();
+  /// @brief Draw the whole mesh with the current fixed-function state.
+  void draw() const;
+  /**
+   * @brief Draw the mesh several times with one call.
+   *
+   * Per-instance attributes must be set up by the caller, see InstancedRenderer.
+   */
+  void drawInstanced(GLsizei instance_count) const;
+  /// @return Number of indices to draw.
+  GLsizei getIndexCount() const { return index_count; }
+  GLuint getVertexBuffer() const { return vbo; }
+  GLuint getIndexBuffer() const { return ibo; }
+
+ private:
+  void bind() const;
+  void unbind() const;
+  void release();
+  GLuint vbo = 0;
+  GLuint ibo = 0;
+  GLsizei index_count = 0;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "job_system.h"
+
+/**
+ * @brief RRT-Connect over the three joint angles of the arm, in degrees.
+ *
+ * One tree grows from the start and one from the goal. Each iteration extends one tree a step towards a random pose,
+ * then pulls the other tree straight towards the new node as far as it stays collision-free. A pose is free if it
+ * touches neither the board, the base nor the arm itself (collision::checkPose without targets). Every edge is tested
+ * at poses resolution_degree apart, all of them in one collision::checkBatch pass split over the job system, which
+ * pays off most for the long edges of the connect step and the shortcut pass.
+ */
+class MotionPlanner final {
+ public:
+  struct Settings {
+    int max_iterations = 2000;
+    /// @brief Longest step one extension takes.
+    float step_degree = 15.0f;
+    /// @brief Spacing of the poses checked along an edge.
+    float resolution_degree = 2.0f;
+    /// @brief Replace the path by straight edges between the farthest visible waypoints.
+    bool shortcut = true;
+    /// @brief Same seed, same start and goal, same path.
+    std::uint32_t seed = 1;
+  };
+  struct Result {
+    /// @brief Waypoints from start to goal, empty if no path was found.
+    std::vector<glm::vec3> path;
+    bool found;
+    int iterations;
+    /// @brief Poses given to the collision check.
+    std::size_t checked_poses;
+    double milliseconds;
+  };
+  /// @brief Planning times over all plan() calls.
+  struct Stats {
+    std::uint64_t plans = 0;
+    std::uint64_t found = 0;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+
+    double getMean() const { return plans > 0 ? total_ms / static_cast<double>(plans) : 0.0; }
+  };
+
+  explicit MotionPlanner(JobSystem& job_system) : jobs(job_system) {}
+  /// @brief Find a collision-free path, only one thread may plan at a time.
+  Result plan(const glm::vec3& start, const glm::vec3& goal, const Settings& settings);
+  Result plan(const glm::vec3& start, const glm::vec3& goal) { return plan(start, goal, Settings()); }
+  const Stats& getStats() const { return stats; }
+  /// @return Whether the arm in pose touches neither the board, the base nor itself.
+  static bool isFree(const glm::vec3& pose);
+
+ private:
+  struct Tree {
+    std::vector<glm::vec3> nodes;
+    std::vector<std::uint32_t> parents;
+
+    std::uint32_t add(const glm::vec3& node, std::uint32_t parent);
+    std::uint32_t nearest(const glm::vec3& pose) const;
+  };
+  static constexpr std::uint32_t ROOT = ~std::uint32_t(0);
+  /// @brief Most poses one thread checks in a row.
+  static constexpr std::size_t CHECK_GRAIN = 64;
+
+  /// @return Fraction of the edge from -> to that is free, starting at from. 1 if all of it is.
+  float checkEdge(const glm::vec3& from, const glm::vec3& to, float resolution_degree);
+  /// @brief Grow tree towards pose by at most step_degree. Returns the new node or ROOT if the step collides.
+  std::uint32_t extend(Tree& tree, const glm::vec3& pose, const Settings& settings);
+  /// @brief Grow tree straight towards pose as far as it is free. Returns the last node, reached tells if it is pose.
+  std::uint32_t connect(Tree& tree, const glm::vec3& pose, const Settings& settings, bool& reached);
+  std::vector<glm::vec3> shortcut(const std::vector<glm::vec3>& path, const Settings& settings);
+
+  JobSystem& jobs;
+  Stats stats;
+  std::size_t checked_poses = 0;
+  // Planes for batched checks, kept between calls so planning stops allocating once they are large enough
+  std::vector<float> joint0, joint1, joint2, zero, far_below;
+  std::vector<std::uint8_t> contacts;
+};
@@ -18,11 +18,15 @@ class OpenGLContext final {
    * @param GLversion Minimal version of OpenGL context, (pass 41 if you want OpenGL 4.1 context)
    * @param profile OpenGL profile, can be one of GLFW_OPENGL_CORE_PROFILE, GLFW_OPENGL_ANY_PROFILE or
    * GLFW_OPENGL_COMPAT_PROFILE. Note that for GLversion < 32, you should always use GLFW_OPENGL_ANY_PROFILE
+   * @param headless Create an invisible window with an OSMesa software context, no display is needed when GLFW is
+   * built with GLFW_USE_OSMESA
    *
    */
-  static void createContext(int GLversion, int profile);
+  static void createContext(int GLversion, int profile, bool headless = false);
   /// @return Current window handle.
   static GLFWwindow* getWindow() { return window; }
+  /// @return Whether the context renders offscreen.
+  static bool isHeadless() { return headless; }
   /// @return Refresh rate of the primary monitor.
   static int getRefreshRate() { return refresh_rate; }
   /// @return Current framebuffer width
@@ -43,6 +47,7 @@ class OpenGLContext final {
   OpenGLContext();
   static int major_version, minor_version;
   static int profile;
+  static bool headless;
   // Cached data
   static GLFWwindow* window;
   static int refresh_rate;
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+
+#include "frame_pacer.h"
+
+/// @brief Command-line options of HW1.
+struct Options {
+  /// @brief Create an OpenGL core-profile context and render with shaders only.
+  bool core_profile = false;
+  /// @brief Render into an invisible offscreen context, also enabled by a non-empty HW1_HEADLESS environment variable.
+  bool headless = false;
+  /// @brief Exit after this many frames, 0 runs until the window is closed.
+  int frames = 0;
+  /// @brief Write every frame as PPM into this directory, empty disables capture.
+  std::string capture_directory;
+  /// @brief Swap interval of windowed runs, headless runs never wait for vsync.
+  VsyncMode vsync = VsyncMode::ON;
+  /// @brief Frame rate cap, 0 renders as fast as vsync allows.
+  double fps = 0.0;
+  /// @brief Number of arms, more than one switches to the animated stress scene.
+  int arms = 1;
+  /// @brief Simulation steps per second, independent of the frame rate.
+  double sim_rate = 60.0;
+  /// @brief Simulate on a separate thread, the render loop only reads published snapshots.
+  bool threaded = false;
+  /// @brief Baked reachability map, reach_map.bin next to the executable unless given.
+  std::string reach_map_path;
+  /// @brief Record key and camera input with frame times into this file, empty disables recording.
+  std::string record_path;
+  /// @brief Replay a recorded input log instead of reading the window, empty disables replay.
+  std::string replay_path;
+
+  /// @brief Frame count used by headless runs that do not pass --frames.
+  static constexpr int DEFAULT_HEADLESS_FRAMES = 600;
+
+  /**
+   * @brief Parse command-line arguments.
+   *
+   * Throws std::invalid_argument on unknown or malformed arguments.
+   */
+  static Options parse(int argc, char** argv);
+  /// @brief Print available options to stdout.
+  static void printUsage(const char* program);
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include <glm/glm.hpp>
+
+#include "arm_dimensions.h"
+#include "arm_kinematics.h"
+#include "utils.h"
+
+/**
+ * @brief Voxel bitset of where the end effector can go without colliding, memory-mapped from a baked file.
+ *
+ * bake() sweeps all three joints in ANGLE_STEP_DEGREE steps, drops poses that touch the board, the base or the arm
+ * itself, and sets the voxel of every remaining end effector. Voxels are VOXEL_SIZE wide, so their diagonal is below
+ * TOLERANCE: a set voxel means every point in it is within TOLERANCE of a reachable pose. Points next to the edge of
+ * the reachable region may still report false.
+ *
+ * The file stores a hash of the arm dimensions and grid layout. A file baked for other dimensions is rejected, and
+ * the map has to be baked again with the BakeReachMap tool, which the build runs whenever the dimensions change.
+ */
+class ReachMap final {
+ public:
+  static constexpr float VOXEL_SIZE = TOLERANCE / 2;
+  /// @brief End effector moves less than VOXEL_SIZE per step of any single joint.
+  static constexpr float ANGLE_STEP_DEGREE = 1.0f;
+  /// @brief Farthest the end effector gets from joint1.
+  static constexpr float MAX_REACH = kinematics::LINK2_LENGTH + kinematics::LINK3_LENGTH;
+
+  /**
+   * @brief Map a baked file.
+   *
+   * Throws std::runtime_error if the file cannot be mapped or was baked for other arm dimensions.
+   */
+  explicit ReachMap(const std::filesystem::path& path);
+  // Not copyable
+  DELETE_COPY(ReachMap)
+  // Not movable
+  DELETE_MOVE(ReachMap)
+  ~ReachMap();
+  /// @brief Sweep the joint space on thread_count threads and write the map to path.
+  static void bake(const std::filesystem::path& path, unsigned thread_count);
+  /// @return reach_map.bin in the directory of the running program, program is its argv[0].
+  static std::filesystem::path getDefaultPath(const char* program);
+  /// @return Whether the file exists and matches the current arm dimensions, without keeping it mapped.
+  static bool isCurrent(const std::filesystem::path& path);
+  /// @return Whether the end effector can get within TOLERANCE of point, relative to the base.
+  bool isReachable(const glm::vec3& point) const {
+    const glm::ivec3 cell(glm::floor((point - ORIGIN) * (1.0f / VOXEL_SIZE)));
+    if (glm::any(glm::lessThan(cell, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(cell, SIZE))) return false;
+    const std::size_t index = (static_cast<std::size_t>(cell.y) * SIZE.z + cell.z) * SIZE.x + cell.x;
+    return (bits[index / 64] >> (index % 64)) & 1;
+  }
+
+ private:
+  static constexpr glm::vec3 ORIGIN{-MAX_REACH, -CATCH_POSITION_OFFSET, -MAX_REACH};
+  static constexpr glm::ivec3 SIZE{static_cast<int>(2 * MAX_REACH / VOXEL_SIZE) + 1,
+                                   static_cast<int>((kinematics::JOINT1_HEIGHT + MAX_REACH + CATCH_POSITION_OFFSET) /
+                                                    VOXEL_SIZE) + 1,
+                                   static_cast<int>(2 * MAX_REACH / VOXEL_SIZE) + 1};
+  static constexpr std::size_t WORD_COUNT = (static_cast<std::size_t>(SIZE.x) * SIZE.y * SIZE.z + 63) / 64;
+
+  struct Header;
+  static std::uint64_t getDimensionHash();
+
+  void* mapping = nullptr;
+  std::size_t mapping_size = 0;
+#ifdef _WIN32
+  void* file_mapping = nullptr;
+#endif
+  const std::uint64_t* bits = nullptr;
+};
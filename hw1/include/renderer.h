@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+
+/// @brief Per-instance data, laid out as it is uploaded to the instance buffer.
+struct Instance {
+  glm::mat4 model;
+  // Inverse transpose of the model matrix, keeps normals correct under non-uniform scale.
+  glm::mat3 normal_model;
+  glm::vec3 color;
+  /// @brief Build an instance and precompute its normal matrix.
+  static Instance create(const glm::mat4& model, const glm::vec3& color);
+};
+
+/// @brief Point light, position is in world space.
+struct Light {
+  glm::vec4 position{50.0f, 75.0f, 80.0f, 1.0f};
+  glm::vec4 ambient{0.4f, 0.4f, 0.4f, 1.0f};
+  glm::vec4 diffuse{0.6f, 0.6f, 0.6f, 1.0f};
+  glm::vec4 specular{0.6f, 0.6f, 0.6f, 1.0f};
+};
+
+/// @brief Common interface of the fixed-function and core-profile render paths.
+class Renderer {
+ public:
+  virtual ~Renderer() = default;
+  /**
+   * @brief Set up camera and light for the coming draws, call once per frame.
+   *
+   * @param view View matrix
+   * @param projection Projection matrix
+   * @param light Light in world space
+   * @param lighting Use flat colors if false
+   */
+  virtual void beginFrame(const glm::mat4& view, const glm::mat4& projection, const Light& light, bool lighting) = 0;
+  /// @brief Draw all instances of the mesh.
+  virtual void draw(const Mesh& mesh, const std::vector<Instance>& instances) = 0;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+#include "transform_graph.h"
+
+/**
+ * @brief Transform hierarchy of the robotic arm.
+ *
+ * base -> joint0 (yaw) -> arm1, joint1 (pitch) -> arm2, joint2 (pitch) -> arm3, end effector.
+ * Rendering and catch detection read the same cached matrices, and a joint change only recomputes its subtree.
+ */
+class RobotArm {
+ public:
+  /// @brief Drawn parts, each one is a unit cylinder scaled by its model matrix.
+  enum Part { BASE, ARM1, JOINT1, ARM2, JOINT2, ARM3, PART_COUNT };
+  static constexpr std::size_t JOINT_COUNT = 3;
+
+  explicit RobotArm(const glm::vec3& base_position = glm::vec3(0.0f));
+  /// @return Transform from the unit cylinder to the part in its pivot frame.
+  static glm::mat4 getPartShape(Part part);
+  /// @brief Set joint angles in degrees, unchanged joints keep their cached matrices.
+  void setJointAngles(float joint0_degree, float joint1_degree, float joint2_degree);
+  void setBasePosition(const glm::vec3& position);
+  /// @return Number of recomputed nodes, 0 if no joint changed since the last call.
+  std::size_t update() { return graph.update(); }
+  /// @return Model matrix that maps the unit cylinder to the part.
+  const glm::mat4& getPartModel(Part part) const { return graph.getWorld(parts[part]); }
+  /// @return Catch position at CATCH_POSITION_OFFSET past the tip of the last arm.
+  glm::vec3 getEndEffectorPosition() const { return graph.getWorldPosition(end_effector); }
+
+ private:
+  TransformGraph graph;
+  int root;
+  std::array<int, JOINT_COUNT> joints;
+  std::array<int, PART_COUNT> parts;
+  int end_effector;
+};
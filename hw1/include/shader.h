@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "utils.h"
+
+/**
+ * @brief Linked GLSL program built from vertex and fragment shader sources.
+ *
+ * Compile or link failures throw std::runtime_error with the driver's info log.
+ */
+class ShaderProgram final {
+ public:
+  /// @brief Attribute name and location pair, bound before linking.
+  struct AttributeBinding {
+    GLuint location;
+    const char* name;
+  };
+
+  ShaderProgram() = default;
+  ShaderProgram(const std::string& vertex_source, const std::string& fragment_source,
+                const std::vector<AttributeBinding>& attributes = {});
+  // Not copyable
+  DELETE_COPY(ShaderProgram)
+  ShaderProgram(ShaderProgram&& other) noexcept;
+  ShaderProgram& operator=(ShaderProgram&& other) noexcept;
+  /// @brief Release program object
+  ~ShaderProgram();
+
+  void use() const;
+  /// @return Uniform location, or -1 if the uniform is not active.
+  GLint getUniformLocation(const char* name) const { return glGetUniformLocation(program, name); }
+  GLuint getHandle() const { return program; }
+
+ private:
+  static GLuint compile(GLenum type, const std::string& source);
+  void release();
+  GLuint program = 0;
+};
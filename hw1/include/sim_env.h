@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Many independent copies of the single-arm task, stepped in lock-step without a window or GL context.
+ *
+ * Each environment is one arm with its base at the origin and one target on the board, with the same rules as the
+ * interactive arm: joints turn by the given deltas, a grabbing arm catches the target within TOLERANCE and carries
+ * it, and a released target falls at DROP_SPEED while drop is set. State is kept as one contiguous array per
+ * quantity, so a step is a few linear passes and forward kinematics run through kinematics::forwardBatch.
+ */
+class SimEnv {
+ public:
+  /// @brief Per-environment inputs of one step, each a plane of size() values.
+  struct Actions {
+    /// @brief Joint changes in degrees.
+    const float* joint0_delta;
+    const float* joint1_delta;
+    const float* joint2_delta;
+    const std::uint8_t* grab;
+    const std::uint8_t* drop;
+  };
+
+  /// @param seed Seeds the target placement of reset(), same seed, same episodes.
+  explicit SimEnv(std::size_t count, std::uint32_t seed = 1);
+  std::size_t size() const { return joint0.size(); }
+  /// @brief Restart every environment.
+  void reset();
+  /// @brief Restart one environment: joints at zero, target at a random spot on the board within reach.
+  void reset(std::size_t env);
+  /// @brief Advance all environments by dt seconds.
+  void step(const Actions& actions, float dt);
+
+  glm::vec3 getJoints(std::size_t env) const { return glm::vec3(joint0[env], joint1[env], joint2[env]); }
+  glm::vec3 getEndEffectorPosition(std::size_t env) const { return glm::vec3(end_x[env], end_y[env], end_z[env]); }
+  glm::vec3 getTargetPosition(std::size_t env) const { return glm::vec3(target_x[env], target_y[env], target_z[env]); }
+  /// @return Whether the arm held the target after the last step.
+  bool isCaught(std::size_t env) const { return caught[env] != 0; }
+
+ private:
+  std::mt19937 random;
+  std::vector<float> joint0, joint1, joint2;
+  std::vector<float> end_x, end_y, end_z;
+  std::vector<float> target_x, target_y, target_z;
+  std::vector<std::uint8_t> caught;
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+/**
+ * @brief Thin float vector wrapper over AVX, SSE4.1 or plain scalars.
+ *
+ * The widest instruction set enabled at compile time is picked, -march=native (or /arch on MSVC) decides. Kernels are
+ * written once against FloatV and MaskV and process FloatV::WIDTH lanes per step.
+ */
+namespace simd {
+#if defined(__AVX__)
+struct FloatV {
+  static constexpr int WIDTH = 8;
+  __m256 v;
+  static FloatV load(const float* p) { return {_mm256_loadu_ps(p)}; }
+  static FloatV broadcast(float x) { return {_mm256_set1_ps(x)}; }
+  void store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+struct MaskV {
+  __m256 v;
+};
+inline FloatV operator+(FloatV a, FloatV b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline FloatV operator-(FloatV a, FloatV b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline FloatV operator*(FloatV a, FloatV b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline FloatV operator/(FloatV a, FloatV b) { return {_mm256_div_ps(a.v, b.v)}; }
+inline FloatV min(FloatV a, FloatV b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline FloatV max(FloatV a, FloatV b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline FloatV sqrt(FloatV a) { return {_mm256_sqrt_ps(a.v)}; }
+inline FloatV round(FloatV a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+inline FloatV floor(FloatV a) { return {_mm256_floor_ps(a.v)}; }
+inline MaskV operator<(FloatV a, FloatV b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline MaskV operator<=(FloatV a, FloatV b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+inline MaskV operator>(FloatV a, FloatV b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+inline MaskV operator>=(FloatV a, FloatV b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+inline MaskV operator&(MaskV a, MaskV b) { return {_mm256_and_ps(a.v, b.v)}; }
+inline MaskV operator|(MaskV a, MaskV b) { return {_mm256_or_ps(a.v, b.v)}; }
+/// @return Lanes of a where mask is set, lanes of b elsewhere.
+inline FloatV select(MaskV mask, FloatV a, FloatV b) { return {_mm256_blendv_ps(b.v, a.v, mask.v)}; }
+/// @return Bit i is set if lane i of the mask is set.
+inline int moveMask(MaskV mask) { return _mm256_movemask_ps(mask.v); }
+#elif defined(__SSE4_1__)
+struct FloatV {
+  static constexpr int WIDTH = 4;
+  __m128 v;
+  static FloatV load(const float* p) { return {_mm_loadu_ps(p)}; }
+  static FloatV broadcast(float x) { return {_mm_set1_ps(x)}; }
+  void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+struct MaskV {
+  __m128 v;
+};
+inline FloatV operator+(FloatV a, FloatV b) { return {_mm_add_ps(a.v, b.v)}; }
+inline FloatV operator-(FloatV a, FloatV b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline FloatV operator*(FloatV a, FloatV b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline FloatV operator/(FloatV a, FloatV b) { return {_mm_div_ps(a.v, b.v)}; }
+inline FloatV min(FloatV a, FloatV b) { return {_mm_min_ps(a.v, b.v)}; }
+inline FloatV max(FloatV a, FloatV b) { return {_mm_max_ps(a.v, b.v)}; }
+inline FloatV sqrt(FloatV a) { return {_mm_sqrt_ps(a.v)}; }
+inline FloatV round(FloatV a) { return {_mm_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+inline FloatV floor(FloatV a) { return {_mm_floor_ps(a.v)}; }
+inline MaskV operator<(FloatV a, FloatV b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline MaskV operator<=(FloatV a, FloatV b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline MaskV operator>(FloatV a, FloatV b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline MaskV operator>=(FloatV a, FloatV b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+inline MaskV operator&(MaskV a, MaskV b) { return {_mm_and_ps(a.v, b.v)}; }
+inline MaskV operator|(MaskV a, MaskV b) { return {_mm_or_ps(a.v, b.v)}; }
+inline FloatV select(MaskV mask, FloatV a, FloatV b) { return {_mm_blendv_ps(b.v, a.v, mask.v)}; }
+inline int moveMask(MaskV mask) { return _mm_movemask_ps(mask.v); }
+#else
+struct FloatV {
+  static constexpr int WIDTH = 1;
+  float v;
+  static FloatV load(const float* p) { return {*p}; }
+  static FloatV broadcast(float x) { return {x}; }
+  void store(float* p) const { *p = v; }
+};
+struct MaskV {
+  bool v;
+};
+inline FloatV operator+(FloatV a, FloatV b) { return {a.v + b.v}; }
+inline FloatV operator-(FloatV a, FloatV b) { return {a.v - b.v}; }
+inline FloatV operator*(FloatV a, FloatV b) { return {a.v * b.v}; }
+inline FloatV operator/(FloatV a, FloatV b) { return {a.v / b.v}; }
+inline FloatV min(FloatV a, FloatV b) { return {a.v < b.v ? a.v : b.v}; }
+inline FloatV max(FloatV a, FloatV b) { return {a.v > b.v ? a.v : b.v}; }
+inline FloatV sqrt(FloatV a) { return {std::sqrt(a.v)}; }
+inline FloatV round(FloatV a) { return {std::nearbyint(a.v)}; }
+inline FloatV floor(FloatV a) { return {std::floor(a.v)}; }
+inline MaskV operator<(FloatV a, FloatV b) { return {a.v < b.v}; }
+inline MaskV operator<=(FloatV a, FloatV b) { return {a.v <= b.v}; }
+inline MaskV operator>(FloatV a, FloatV b) { return {a.v > b.v}; }
+inline MaskV operator>=(FloatV a, FloatV b) { return {a.v >= b.v}; }
+inline MaskV operator&(MaskV a, MaskV b) { return {a.v && b.v}; }
+inline MaskV operator|(MaskV a, MaskV b) { return {a.v || b.v}; }
+inline FloatV select(MaskV mask, FloatV a, FloatV b) { return mask.v ? a : b; }
+inline int moveMask(MaskV mask) { return mask.v ? 1 : 0; }
+#endif
+
+inline FloatV operator-(FloatV a) { return FloatV::broadcast(0.0f) - a; }
+inline FloatV clamp(FloatV x, FloatV low, FloatV high) { return min(max(x, low), high); }
+inline FloatV abs(FloatV a) { return max(a, -a); }
+
+/**
+ * @brief Sine and cosine of every lane, in radians.
+ *
+ * Cephes-style: reduce by multiples of pi/2 in three parts, then evaluate minimax polynomials on [-pi/4, pi/4].
+ * Absolute error is about 1e-7 for |x| up to a few thousand radians.
+ */
+inline void sincos(FloatV x, FloatV& sin_x, FloatV& cos_x) {
+  const FloatV quadrant = round(x * FloatV::broadcast(0.636619772367581f));
+  FloatV r = x - quadrant * FloatV::broadcast(1.5703125f);
+  r = r - quadrant * FloatV::broadcast(4.837512969970703125e-4f);
+  r = r - quadrant * FloatV::broadcast(7.54978995489188216e-8f);
+  const FloatV r2 = r * r;
+
+  FloatV s = FloatV::broadcast(-1.9515295891e-4f);
+  s = s * r2 + FloatV::broadcast(8.3321608736e-3f);
+  s = s * r2 + FloatV::broadcast(-1.6666654611e-1f);
+  s = s * r2 * r + r;
+  FloatV c = FloatV::broadcast(2.443315711809948e-5f);
+  c = c * r2 + FloatV::broadcast(-1.388731625493765e-3f);
+  c = c * r2 + FloatV::broadcast(4.166664568298827e-2f);
+  c = c * r2 * r2 - FloatV::broadcast(0.5f) * r2 + FloatV::broadcast(1.0f);
+
+  // quadrant mod 4 decides which polynomial gives sine and the signs
+  const FloatV q = quadrant - FloatV::broadcast(4.0f) * floor(quadrant * FloatV::broadcast(0.25f));
+  const FloatV half = FloatV::broadcast(0.5f);
+  const MaskV odd = ((q > half) & (q < FloatV::broadcast(1.5f))) | (q > FloatV::broadcast(2.5f));
+  const FloatV one = FloatV::broadcast(1.0f);
+  const FloatV sin_sign = select(q > FloatV::broadcast(1.5f), -one, one);
+  const FloatV cos_sign = select((q > half) & (q < FloatV::broadcast(2.5f)), -one, one);
+  sin_x = select(odd, c, s) * sin_sign;
+  cos_x = select(odd, s, c) * cos_sign;
+}
+
+/**
+ * @brief Four-quadrant arctangent of every lane, atan2(0, 0) is 0.
+ *
+ * Cephes atanf polynomial on [0, tan(pi/8)] after folding the ratio of the smaller to the larger magnitude into it.
+ * Absolute error is about 2e-7.
+ */
+inline FloatV atan2(FloatV y, FloatV x) {
+  const FloatV abs_y = abs(y), abs_x = abs(x);
+  const FloatV zero = FloatV::broadcast(0.0f);
+  const FloatV larger = max(abs_y, abs_x);
+  FloatV a = min(abs_y, abs_x) / max(larger, FloatV::broadcast(1e-30f));
+  // Fold a in (tan(pi/8), 1] around 1 so the polynomial only sees small arguments
+  const MaskV fold = a > FloatV::broadcast(0.414213562373095f);
+  const FloatV one = FloatV::broadcast(1.0f);
+  a = select(fold, (a - one) / (a + one), a);
+  const FloatV z = a * a;
+  FloatV p = FloatV::broadcast(8.05374449538e-2f);
+  p = p * z - FloatV::broadcast(1.38776856032e-1f);
+  p = p * z + FloatV::broadcast(1.99777106478e-1f);
+  p = p * z - FloatV::broadcast(3.33329491539e-1f);
+  FloatV angle = p * z * a + a + select(fold, FloatV::broadcast(0.785398163397448f), zero);
+
+  angle = select(abs_y > abs_x, FloatV::broadcast(1.570796326794897f) - angle, angle);
+  angle = select(x < zero, FloatV::broadcast(3.141592653589793f) - angle, angle);
+  return select(y < zero, -angle, angle);
+}
+}  // namespace simd
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+#include "arm_scene.h"
+#include "input_events.h"
+#include "triple_buffer.h"
+#include "utils.h"
+
+/**
+ * @brief Fixed-step simulation of an ArmScene on its own thread.
+ *
+ * Input events arrive through a lock-free queue that every step drains in order, results leave through a
+ * TripleBuffer, so neither the render loop nor the simulation ever blocks on the other. Every step copies what
+ * rendering needs, ArmScene::RenderState with the previous step's state for interpolation, into the back slot in
+ * place. Catch state and the target hash never leave the simulation thread.
+ */
+class Simulation final {
+ public:
+  using Clock = std::chrono::steady_clock;
+  /// @brief Immutable result of one step.
+  struct Snapshot {
+    ArmScene::RenderState scene;
+    Clock::time_point published;
+  };
+  /// @brief Most steps run back to back after a stall, older time is dropped.
+  static constexpr int MAX_CATCH_UP_STEPS = 8;
+
+  /// @brief Start simulating count arms at step seconds per step, arm 0 follows the events pushed to input.
+  /// @param planner Plans paths for arm 0 on the simulation thread, may be nullptr.
+  /// @param jobs Splits each step of the scene over its threads, may be nullptr.
+  Simulation(std::size_t count, double step, InputQueue& input, MotionPlanner* planner, JobSystem* jobs);
+  // Not copyable
+  DELETE_COPY(Simulation)
+  // Not movable
+  DELETE_MOVE(Simulation)
+  /// @brief Stop and join the simulation thread.
+  ~Simulation();
+  /// @brief Stop and join the simulation thread, later calls do nothing.
+  void stop();
+  /// @brief Latest complete snapshot, call from the render thread. Valid until the next call.
+  const Snapshot& acquire();
+  /// @return Blend factor from the snapshot's previous to its current state, for rendering now.
+  float getAlpha(const Snapshot& snapshot) const;
+  /// @brief Latency of the events applied so far, only read after stop().
+  const InputLatency& getInputLatency() const { return latency; }
+
+ private:
+  void run();
+
+  std::chrono::duration<double> step;
+  // Working copy owned by the simulation thread, published slots are never touched after publish()
+  ArmScene scene;
+  ArmControl control;
+  InputLatency latency;
+  InputQueue& input;
+  TripleBuffer<Snapshot> output;
+  std::atomic<bool> running{true};
+  std::thread thread;
+};
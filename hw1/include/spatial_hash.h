@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+/**
+ * @brief Uniform grid of points hashed by cell, for neighbourhood queries.
+ *
+ * Every point lives in the cell floor(position / cell_size). Moving a point only touches the map when it crosses
+ * into another cell, so a scene where most points rest or move a little per step keeps the grid up to date almost
+ * for free. Cells that become empty are kept with their capacity, points going back and forth do not allocate.
+ */
+class SpatialHash {
+ public:
+  /// @param cell_size Side length of a cell, at least the largest query radius.
+  explicit SpatialHash(float cell_size);
+  std::size_t size() const { return cells.size(); }
+  /// @brief Add point id, ids are indices starting at 0 and added in order.
+  void insert(std::uint32_t id, const glm::vec3& position);
+  /// @brief Set the position of point id.
+  void update(std::uint32_t id, const glm::vec3& position);
+  /**
+   * @brief Call visit(id) for every point in the cells around position.
+   *
+   * This covers all points within cell_size of position and possibly some further away, callers test the exact
+   * distance.
+   */
+  template <typename Visit>
+  void forEachNear(const glm::vec3& position, Visit&& visit) const {
+    const glm::ivec3 center = getCell(position);
+    for (int x = -1; x <= 1; ++x) {
+      for (int y = -1; y <= 1; ++y) {
+        for (int z = -1; z <= 1; ++z) {
+          const auto found = grid.find(center + glm::ivec3(x, y, z));
+          if (found == grid.end()) continue;
+          for (std::uint32_t id : found->second) visit(id);
+        }
+      }
+    }
+  }
+
+ private:
+  glm::ivec3 getCell(const glm::vec3& position) const { return glm::ivec3(glm::floor(position * inverse_cell_size)); }
+
+  float inverse_cell_size;
+  std::unordered_map<glm::ivec3, std::vector<std::uint32_t>> grid;
+  // Cell each point is currently filed under
+  std::vector<glm::ivec3> cells;
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Storage is a fixed ring of Capacity elements, so pushing and popping never allocate. Each side only writes its own
+ * index and reads the other one with acquire ordering, which makes the element stored before a release store of the
+ * tail visible to the consumer that sees that tail. Both indices count up forever and are masked on access, so a
+ * full ring holds all Capacity elements.
+ *
+ * @tparam Capacity Power of two.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+  static_assert(std::is_trivially_copyable_v<T>, "Elements are copied in and out of the ring");
+
+ public:
+  SpscQueue() = default;
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /// @brief Append value, only call from the producer thread.
+  /// @return False if the queue is full, value is then dropped.
+  bool tryPush(const T& value) {
+    const std::size_t current = tail.load(std::memory_order_relaxed);
+    if (current - cached_head == Capacity) {
+      cached_head = head.load(std::memory_order_acquire);
+      if (current - cached_head == Capacity) return false;
+    }
+    slots[current & MASK] = value;
+    tail.store(current + 1, std::memory_order_release);
+    return true;
+  }
+  /// @brief Take the oldest value, only call from the consumer thread.
+  /// @return False if the queue is empty, value is then unchanged.
+  bool tryPop(T& value) {
+    const std::size_t current = head.load(std::memory_order_relaxed);
+    if (current == cached_tail) {
+      cached_tail = tail.load(std::memory_order_acquire);
+      if (current == cached_tail) return false;
+    }
+    value = slots[current & MASK];
+    head.store(current + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  static constexpr std::size_t MASK = Capacity - 1;
+
+  T slots[Capacity];
+  // Producer side: its index and the last head it saw, so a push only touches the consumer's line when nearly full
+  alignas(64) std::atomic<std::size_t> tail{0};
+  std::size_t cached_head = 0;
+  // Consumer side, likewise
+  alignas(64) std::atomic<std::size_t> head{0};
+  std::size_t cached_tail = 0;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Hierarchy of rigid transforms with cached world matrices.
+ *
+ * Every node has the local transform translate(offset) * rotate(angle, axis) * tail, where tail is a constant matrix
+ * used for part scaling. Nodes are stored parents first, so update() is one linear pass. Only nodes whose angle or
+ * offset changed, and their descendants, are recomputed; when nothing changed update() does no matrix math at all.
+ */
+class TransformGraph {
+ public:
+  /// @brief Index of the parent of a root node.
+  static constexpr int NO_PARENT = -1;
+  /**
+   * @brief Append a node, its parent must already exist.
+   *
+   * @param parent Parent node index or NO_PARENT
+   * @param offset Translation from the parent frame to the pivot
+   * @param axis Rotation axis in the parent frame, the angle starts at 0
+   * @param tail Constant transform applied after the rotation, do not attach children to scaled nodes
+   * @return Index of the new node.
+   */
+  int addNode(int parent, const glm::vec3& offset, const glm::vec3& axis = glm::vec3(0.0f, 1.0f, 0.0f),
+              const glm::mat4& tail = glm::mat4(1.0f));
+  /// @brief Set rotation angle in degrees, marks the subtree dirty only when the value changes.
+  void setAngle(int node, float degrees);
+  /// @brief Set translation from the parent frame, marks the subtree dirty only when the value changes.
+  void setOffset(int node, const glm::vec3& offset);
+  /// @return Number of nodes whose world matrix was recomputed.
+  std::size_t update();
+  /// @return World matrix of the node as of the last update.
+  const glm::mat4& getWorld(int node) const { return world[node]; }
+  /// @return Origin of the node frame in world space as of the last update.
+  glm::vec3 getWorldPosition(int node) const { return glm::vec3(world[node][3]); }
+  std::size_t size() const { return parents.size(); }
+
+ private:
+  std::vector<int> parents;
+  std::vector<glm::vec3> offsets;
+  std::vector<glm::vec3> axes;
+  std::vector<float> angles;
+  std::vector<glm::mat4> tails;
+  std::vector<glm::mat4> world;
+  std::vector<char> dirty;
+  bool any_dirty = false;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Wait-free single producer, single consumer exchange of the latest value.
+ *
+ * The writer fills the back slot and publishes it by swapping it with the middle slot. The reader swaps the middle
+ * slot with its front slot only if something new was published. Each side owns one slot exclusively at any time, so
+ * neither ever waits, and the reader always sees a complete value. Values that are overwritten before the reader
+ * gets to them are skipped.
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  /// @brief All three slots start as copies of initial.
+  explicit TripleBuffer(const T& initial) : slots{Slot{initial}, Slot{initial}, Slot{initial}} {}
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  /// @brief Slot the writer may fill, only call from the writer thread.
+  T& back() { return slots[back_index].value; }
+  /// @brief Make back() visible to the reader and get a fresh back slot.
+  void publish() {
+    back_index = middle.exchange(static_cast<std::uint8_t>(back_index | FRESH), std::memory_order_acq_rel) & INDEX_MASK;
+  }
+  /**
+   * @brief Take the latest published value if there is one, only call from the reader thread.
+   *
+   * @return True if front() changed.
+   */
+  bool update() {
+    if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+    front_index = middle.exchange(front_index, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+  /// @brief Latest value taken by update().
+  const T& front() const { return slots[front_index].value; }
+
+ private:
+  static constexpr std::uint8_t INDEX_MASK = 0x3;
+  static constexpr std::uint8_t FRESH = 0x4;
+  // Keep slots on separate cache lines, writer and reader touch different ones
+  struct alignas(64) Slot {
+    T value;
+  };
+
+  Slot slots[3];
+  std::uint8_t back_index = 0;
+  alignas(64) std::atomic<std::uint8_t> middle{1};
+  alignas(64) std::uint8_t front_index = 2;
+};
@@ -82,6 +82,31 @@ constexpr inline T PI_2() {
   return static_cast<T>(M_PI_2);
 }
 
+/// @brief Sine usable in constant expressions, accurate to double precision on [-2pi, 2pi].
+constexpr inline double constexprSin(double x) {
+  // Reduce to [-pi, pi] so the Taylor series converges quickly
+  while (x > M_PI) x -= 2 * M_PI;
+  while (x < -M_PI) x += 2 * M_PI;
+  double term = x, sum = x;
+  for (int n = 1; n < 16; ++n) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+/// @brief Cosine usable in constant expressions, accurate to double precision on [-2pi, 2pi].
+constexpr inline double constexprCos(double x) {
+  while (x > M_PI) x -= 2 * M_PI;
+  while (x < -M_PI) x += 2 * M_PI;
+  double term = 1, sum = 1;
+  for (int n = 1; n < 16; ++n) {
+    term *= -x * x / ((2 * n - 1) * (2 * n));
+    sum += term;
+  }
+  return sum;
+}
+
 #if HAS_CXX20_SUPPORT
 constexpr inline uint32_t log2(uint32_t n) { return std::bit_width(n) - 1; }
 #else
@@ -0,0 +1,161 @@
+#include "arm_collision.h"
+
+#include <algorithm>
+
+#include "arm_dimensions.h"
+#include "arm_kinematics.h"
+#include "simd.h"
+
+namespace collision {
+namespace {
+using simd::FloatV;
+using simd::MaskV;
+
+constexpr float DEGREE_TO_RADIAN = 0.017453292519943295f;
+/// @brief Length of the arm3 segment, from joint2 to the end of the cylinder.
+constexpr float ARM3_LENGTH = JOINT_RADIUS + ARM_LEN;
+/**
+ * @brief Stretch of arm3 next to joint2 that is not tested against arm2.
+ *
+ * Both links always overlap around the shared pivot. Past this distance arm3 only comes within 2 * ARM_RADIUS of arm2
+ * once |joint2| exceeds 180 - asin(2 * ARM_RADIUS / JOINT2_CLEARANCE) = 150 degrees, i.e. when the arm folds back.
+ */
+constexpr float JOINT2_CLEARANCE = 4 * ARM_RADIUS;
+
+struct Vec3V {
+  FloatV x, y, z;
+};
+inline Vec3V operator+(const Vec3V& a, const Vec3V& b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+inline Vec3V operator-(const Vec3V& a, const Vec3V& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline Vec3V operator*(FloatV s, const Vec3V& a) { return {s * a.x, s * a.y, s * a.z}; }
+inline FloatV dot(const Vec3V& a, const Vec3V& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+/**
+ * @brief Squared distance between segments p1-q1 and p2-q2, both of nonzero length.
+ *
+ * Closest points as in Ericson, Real-Time Collision Detection 5.1.9, with the branches turned into selects.
+ */
+FloatV segmentDistance2(const Vec3V& p1, const Vec3V& q1, const Vec3V& p2, const Vec3V& q2) {
+  const Vec3V d1 = q1 - p1, d2 = q2 - p2, r = p1 - p2;
+  const FloatV a = dot(d1, d1), e = dot(d2, d2), b = dot(d1, d2), c = dot(d1, r), f = dot(d2, r);
+  const FloatV zero = FloatV::broadcast(0.0f), one = FloatV::broadcast(1.0f);
+  const FloatV denominator = a * e - b * b;
+  // Parallel segments have no unique closest pair, any s works and 0 is as good as the rest
+  FloatV s = simd::select(denominator > FloatV::broadcast(1e-12f),
+                          simd::clamp((b * f - c * e) / simd::max(denominator, FloatV::broadcast(1e-12f)), zero, one),
+                          zero);
+  const FloatV t_unclamped = (b * s + f) / e;
+  s = simd::select(t_unclamped < zero, simd::clamp(-c / a, zero, one),
+                   simd::select(t_unclamped > one, simd::clamp((b - c) / a, zero, one), s));
+  const FloatV t = simd::clamp(t_unclamped, zero, one);
+  const Vec3V between = (p1 + s * d1) - (p2 + t * d2);
+  return dot(between, between);
+}
+
+/**
+ * @brief Whether capsule a-b of ARM_RADIUS touches the vertical cylinder at (center_x, center_z) spanning
+ * [bottom, top].
+ *
+ * The segment is clipped to the height range grown by ARM_RADIUS, then the clipped part's closest horizontal approach
+ * to the axis is compared with radius + ARM_RADIUS.
+ */
+MaskV touchesCylinder(const Vec3V& a, const Vec3V& b, FloatV center_x, FloatV center_z, FloatV bottom, FloatV top,
+                      FloatV radius) {
+  const FloatV zero = FloatV::broadcast(0.0f), one = FloatV::broadcast(1.0f);
+  const FloatV capsule_radius = FloatV::broadcast(ARM_RADIUS);
+  const Vec3V d = b - a;
+  // Near-horizontal segments get a tiny positive slope, their clip range is then all or nothing as it should be
+  const FloatV epsilon = FloatV::broadcast(1e-6f);
+  const FloatV dy = simd::select(simd::abs(d.y) < epsilon, epsilon, d.y);
+  const FloatV t_bottom = (bottom - capsule_radius - a.y) / dy, t_top = (top + capsule_radius - a.y) / dy;
+  const FloatV t_enter = simd::max(simd::min(t_bottom, t_top), zero);
+  const FloatV t_exit = simd::min(simd::max(t_bottom, t_top), one);
+  const FloatV to_x = center_x - a.x, to_z = center_z - a.z;
+  const FloatV length2 = simd::max(d.x * d.x + d.z * d.z, FloatV::broadcast(1e-12f));
+  const FloatV t = simd::clamp((to_x * d.x + to_z * d.z) / length2, t_enter, t_exit);
+  const FloatV off_x = a.x + t * d.x - center_x, off_z = a.z + t * d.z - center_z;
+  const FloatV reach = radius + capsule_radius;
+  return (t_enter <= t_exit) & (off_x * off_x + off_z * off_z < reach * reach);
+}
+
+/// @brief One FloatV of arms, shared by full chunks and the padded tail.
+void checkLanes(const float* joint0, const float* joint1, const float* joint2, const float* base_x,
+                const float* base_z, const float* target_x, const float* target_y, const float* target_z,
+                std::uint8_t* contacts) {
+  const FloatV to_radian = FloatV::broadcast(DEGREE_TO_RADIAN);
+  const FloatV yaw = FloatV::load(joint0) * to_radian;
+  const FloatV pitch1 = FloatV::load(joint1) * to_radian;
+  const FloatV pitch2 = pitch1 + FloatV::load(joint2) * to_radian;
+  FloatV sin_yaw, cos_yaw, sin1, cos1, sin2, cos2;
+  simd::sincos(yaw, sin_yaw, cos_yaw);
+  simd::sincos(pitch1, sin1, cos1);
+  simd::sincos(pitch2, sin2, cos2);
+
+  const FloatV zero = FloatV::broadcast(0.0f);
+  const Vec3V joint1_pivot{zero, FloatV::broadcast(kinematics::JOINT1_HEIGHT), zero};
+  const Vec3V joint2_pivot = joint1_pivot + FloatV::broadcast(kinematics::LINK2_LENGTH) *
+                                                Vec3V{sin1 * sin_yaw, cos1, sin1 * cos_yaw};
+  const Vec3V arm3_end = joint2_pivot + FloatV::broadcast(ARM3_LENGTH) * Vec3V{sin2 * sin_yaw, cos2, sin2 * cos_yaw};
+
+  const FloatV arm_radius = FloatV::broadcast(ARM_RADIUS);
+  const MaskV ground = simd::min(joint2_pivot.y, arm3_end.y) < arm_radius;
+
+  const FloatV base_top = FloatV::broadcast(BASE_HEIGHT), base_radius = FloatV::broadcast(BASE_RADIUS);
+  const MaskV base = touchesCylinder(joint1_pivot, joint2_pivot, zero, zero, zero, base_top, base_radius) |
+                     touchesCylinder(joint2_pivot, arm3_end, zero, zero, zero, base_top, base_radius);
+
+  // Arm3 against arm1, and against arm2 beyond the stretch both share at joint2
+  const Vec3V arm1_bottom{zero, base_top, zero};
+  const Vec3V arm1_top{zero, FloatV::broadcast(BASE_HEIGHT + ARM_LEN), zero};
+  const Vec3V arm3_outer =
+      joint2_pivot + FloatV::broadcast(JOINT2_CLEARANCE) * Vec3V{sin2 * sin_yaw, cos2, sin2 * cos_yaw};
+  const FloatV self_reach2 = (arm_radius + arm_radius) * (arm_radius + arm_radius);
+  const MaskV self = (segmentDistance2(joint2_pivot, arm3_end, arm1_bottom, arm1_top) < self_reach2) |
+                     (segmentDistance2(arm3_outer, arm3_end, joint1_pivot, joint2_pivot) < self_reach2);
+
+  const FloatV center_x = FloatV::load(target_x) - FloatV::load(base_x);
+  const FloatV center_z = FloatV::load(target_z) - FloatV::load(base_z);
+  const FloatV half_height = FloatV::broadcast(TARGET_HEIGHT / 2);
+  const FloatV target_bottom = FloatV::load(target_y) - half_height, target_top = FloatV::load(target_y) + half_height;
+  const FloatV target_radius = FloatV::broadcast(TARGET_RADIUS);
+  const MaskV target =
+      touchesCylinder(joint1_pivot, joint2_pivot, center_x, center_z, target_bottom, target_top, target_radius) |
+      touchesCylinder(joint2_pivot, arm3_end, center_x, center_z, target_bottom, target_top, target_radius);
+
+  const int ground_bits = simd::moveMask(ground), base_bits = simd::moveMask(base);
+  const int self_bits = simd::moveMask(self), target_bits = simd::moveMask(target);
+  for (int lane = 0; lane < FloatV::WIDTH; ++lane) {
+    contacts[lane] = static_cast<std::uint8_t>(((ground_bits >> lane) & 1) * GROUND | ((base_bits >> lane) & 1) * BASE |
+                                               ((self_bits >> lane) & 1) * SELF | ((target_bits >> lane) & 1) * TARGET);
+  }
+}
+}  // namespace
+
+std::uint8_t checkPose(float joint0_degree, float joint1_degree, float joint2_degree, const glm::vec3& target) {
+  const float zero = 0.0f;
+  std::uint8_t contacts;
+  checkBatch(&joint0_degree, &joint1_degree, &joint2_degree, &zero, &zero, &target.x, &target.y, &target.z, 1,
+             &contacts);
+  return contacts;
+}
+
+void checkBatch(const float* joint0_degree, const float* joint1_degree, const float* joint2_degree,
+                const float* base_x, const float* base_z, const float* target_x, const float* target_y,
+                const float* target_z, std::size_t count, std::uint8_t* contacts) {
+  constexpr std::size_t WIDTH = FloatV::WIDTH;
+  std::size_t i = 0;
+  for (; i + WIDTH <= count; i += WIDTH) {
+    checkLanes(joint0_degree + i, joint1_degree + i, joint2_degree + i, base_x + i, base_z + i, target_x + i,
+               target_y + i, target_z + i, contacts + i);
+  }
+  if (i == count) return;
+  // Pad the tail to a full vector so every arm goes through the same code
+  float in[8][WIDTH] = {};
+  std::uint8_t out[WIDTH];
+  const std::size_t tail = count - i;
+  const float* planes[8] = {joint0_degree, joint1_degree, joint2_degree, base_x, base_z, target_x, target_y, target_z};
+  for (int plane = 0; plane < 8; ++plane) std::copy_n(planes[plane] + i, tail, in[plane]);
+  checkLanes(in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7], out);
+  std::copy_n(out, tail, contacts + i);
+}
+}  // namespace collision
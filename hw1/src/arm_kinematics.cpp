@@ -0,0 +1,120 @@
+#include "arm_kinematics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "kinematic_chain.h"
+#include "simd.h"
+
+namespace kinematics {
+namespace {
+constexpr float DEGREE_TO_RADIAN = 0.017453292519943295f;
+constexpr float RADIAN_TO_DEGREE = 57.29577951308232f;
+constexpr float COS_NUMERATOR_OFFSET = LINK2_LENGTH * LINK2_LENGTH + LINK3_LENGTH * LINK3_LENGTH;
+constexpr float COS_DENOMINATOR = 2.0f * LINK2_LENGTH * LINK3_LENGTH;
+
+/// @brief One FloatV of poses, shared by full chunks and the padded tail.
+void forwardLanes(const float* joint0, const float* joint1, const float* joint2, float* x, float* y, float* z) {
+  using simd::FloatV;
+  const FloatV to_radian = FloatV::broadcast(DEGREE_TO_RADIAN);
+  const FloatV yaw = FloatV::load(joint0) * to_radian;
+  const FloatV pitch1 = FloatV::load(joint1) * to_radian;
+  const FloatV pitch2 = pitch1 + FloatV::load(joint2) * to_radian;
+  FloatV sin_yaw, cos_yaw, sin1, cos1, sin2, cos2;
+  simd::sincos(yaw, sin_yaw, cos_yaw);
+  simd::sincos(pitch1, sin1, cos1);
+  simd::sincos(pitch2, sin2, cos2);
+  const FloatV link2 = FloatV::broadcast(LINK2_LENGTH);
+  const FloatV link3 = FloatV::broadcast(LINK3_LENGTH);
+  const FloatV reach = link2 * sin1 + link3 * sin2;
+  (reach * sin_yaw).store(x);
+  (FloatV::broadcast(JOINT1_HEIGHT) + link2 * cos1 + link3 * cos2).store(y);
+  (reach * cos_yaw).store(z);
+}
+
+/// @brief One FloatV of targets, shared by full chunks and the padded tail.
+int inverseLanes(const float* x, const float* y, const float* z, float* joint0, float* joint1, float* joint2,
+                 bool elbow_up) {
+  using simd::FloatV;
+  const FloatV target_x = FloatV::load(x), target_z = FloatV::load(z);
+  const FloatV height = FloatV::load(y) - FloatV::broadcast(JOINT1_HEIGHT);
+  const FloatV reach = simd::sqrt(target_x * target_x + target_z * target_z);
+  const FloatV cos2 = (reach * reach + height * height - FloatV::broadcast(COS_NUMERATOR_OFFSET)) /
+                      FloatV::broadcast(COS_DENOMINATOR);
+  const FloatV one = FloatV::broadcast(1.0f);
+  const simd::MaskV reachable = (cos2 >= -one) & (cos2 <= one);
+  const FloatV clamped = simd::clamp(cos2, -one, one);
+  FloatV sin2 = simd::sqrt(one - clamped * clamped);
+  if (elbow_up) sin2 = -sin2;
+  const FloatV angle2 = simd::atan2(sin2, clamped);
+  const FloatV link2 = FloatV::broadcast(LINK2_LENGTH), link3 = FloatV::broadcast(LINK3_LENGTH);
+  const FloatV angle1 = simd::atan2(reach, height) - simd::atan2(link3 * sin2, link2 + link3 * clamped);
+  const FloatV to_degree = FloatV::broadcast(RADIAN_TO_DEGREE);
+  (simd::atan2(target_x, target_z) * to_degree).store(joint0);
+  (angle1 * to_degree).store(joint1);
+  (angle2 * to_degree).store(joint2);
+  return simd::moveMask(reachable);
+}
+}  // namespace
+
+glm::vec3 forward(float joint0_degree, float joint1_degree, float joint2_degree) {
+  const float angles[] = {joint0_degree, joint1_degree, joint2_degree};
+  return ArmChain::forward(angles);
+}
+
+void forwardBatch(const float* joint0_degree, const float* joint1_degree, const float* joint2_degree, std::size_t count,
+                  float* x, float* y, float* z) {
+  constexpr std::size_t WIDTH = simd::FloatV::WIDTH;
+  std::size_t i = 0;
+  for (; i + WIDTH <= count; i += WIDTH) {
+    forwardLanes(joint0_degree + i, joint1_degree + i, joint2_degree + i, x + i, y + i, z + i);
+  }
+  if (i == count) return;
+  // Pad the tail to a full vector so every pose goes through the same code
+  float in[3][WIDTH] = {}, out[3][WIDTH];
+  const std::size_t tail = count - i;
+  std::copy_n(joint0_degree + i, tail, in[0]);
+  std::copy_n(joint1_degree + i, tail, in[1]);
+  std::copy_n(joint2_degree + i, tail, in[2]);
+  forwardLanes(in[0], in[1], in[2], out[0], out[1], out[2]);
+  std::copy_n(out[0], tail, x + i);
+  std::copy_n(out[1], tail, y + i);
+  std::copy_n(out[2], tail, z + i);
+}
+
+IkSolution inverse(const glm::vec3& target, bool elbow_up) {
+  const float reach = std::sqrt(target.x * target.x + target.z * target.z);
+  const float height = target.y - JOINT1_HEIGHT;
+  const float cos2 = (reach * reach + height * height - COS_NUMERATOR_OFFSET) / COS_DENOMINATOR;
+  const float clamped = std::clamp(cos2, -1.0f, 1.0f);
+  const float sin2 = (elbow_up ? -1.0f : 1.0f) * std::sqrt(1.0f - clamped * clamped);
+  const float elbow = std::atan2(LINK3_LENGTH * sin2, LINK2_LENGTH + LINK3_LENGTH * clamped);
+  const float angle1 = std::atan2(reach, height) - elbow;
+  return IkSolution{std::atan2(target.x, target.z) * RADIAN_TO_DEGREE, angle1 * RADIAN_TO_DEGREE,
+                    std::atan2(sin2, clamped) * RADIAN_TO_DEGREE, cos2 >= -1.0f && cos2 <= 1.0f};
+}
+
+void inverseBatch(const float* x, const float* y, const float* z, std::size_t count, float* joint0_degree,
+                  float* joint1_degree, float* joint2_degree, std::uint8_t* reachable, bool elbow_up) {
+  constexpr std::size_t WIDTH = simd::FloatV::WIDTH;
+  auto storeReachable = [&](std::size_t first, std::size_t lanes, int mask) {
+    for (std::size_t lane = 0; lane < lanes; ++lane) reachable[first + lane] = (mask >> lane) & 1;
+  };
+  std::size_t i = 0;
+  for (; i + WIDTH <= count; i += WIDTH) {
+    int mask = inverseLanes(x + i, y + i, z + i, joint0_degree + i, joint1_degree + i, joint2_degree + i, elbow_up);
+    storeReachable(i, WIDTH, mask);
+  }
+  if (i == count) return;
+  float in[3][WIDTH] = {}, out[3][WIDTH];
+  const std::size_t tail = count - i;
+  std::copy_n(x + i, tail, in[0]);
+  std::copy_n(y + i, tail, in[1]);
+  std::copy_n(z + i, tail, in[2]);
+  int mask = inverseLanes(in[0], in[1], in[2], out[0], out[1], out[2], elbow_up);
+  std::copy_n(out[0], tail, joint0_degree + i);
+  std::copy_n(out[1], tail, joint1_degree + i);
+  std::copy_n(out[2], tail, joint2_degree + i);
+  storeReachable(i, tail, mask);
+}
+}  // namespace kinematics
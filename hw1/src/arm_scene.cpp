@@ -0,0 +1,176 @@
+#include "arm_scene.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "arm_collision.h"
+#include "arm_dimensions.h"
+#include "arm_kinematics.h"
+
+ArmScene::ArmScene(std::size_t count, JobSystem* job_system)
+    : jobs(job_system),
+      end_x(count),
+      end_y(count),
+      end_z(count),
+      grab(count, 0),
+      drop(count, 1),
+      held(count, NO_TARGET),
+      caught(count, 0),
+      target_hash(TOLERANCE) {
+  state.columns =
+      static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(std::max<std::size_t>(count, 1)))));
+  for (std::vector<float>* plane : {&state.base_x, &state.base_z, &state.joint0, &state.joint1, &state.joint2,
+                                    &state.target_x, &state.target_z}) {
+    plane->assign(count, 0.0f);
+  }
+  state.target_y.assign(count, TARGET_HEIGHT / 2);
+  state.contacts.assign(count, collision::NONE);
+  for (int part = 0; part < RobotArm::PART_COUNT; ++part) {
+    state.part_shapes[part] = RobotArm::getPartShape(static_cast<RobotArm::Part>(part));
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    state.base_x[i] = static_cast<float>(i % state.columns) * GRID_SPACING;
+    state.base_z[i] = -static_cast<float>(i / state.columns) * GRID_SPACING;
+    // Same spot in front of the base as the single arm's target
+    state.target_x[i] = state.base_x[i];
+    state.target_z[i] = state.base_z[i] + 1.0f;
+    target_hash.insert(static_cast<std::uint32_t>(i), getTargetPosition(i));
+  }
+  update(0.0f);
+  beginStep();
+}
+
+void ArmScene::setJointAngles(std::size_t arm, float joint0_degree, float joint1_degree, float joint2_degree) {
+  state.joint0[arm] = joint0_degree;
+  state.joint1[arm] = joint1_degree;
+  state.joint2[arm] = joint2_degree;
+}
+
+void ArmScene::setGrip(std::size_t arm, bool grab_target, bool drop_target) {
+  grab[arm] = grab_target;
+  drop[arm] = drop_target;
+}
+
+void ArmScene::beginStep() {
+  state.previous_joint0 = state.joint0;
+  state.previous_joint1 = state.joint1;
+  state.previous_joint2 = state.joint2;
+  state.previous_target_x = state.target_x;
+  state.previous_target_y = state.target_y;
+  state.previous_target_z = state.target_z;
+}
+
+void ArmScene::animate(double time, std::size_t first) {
+  const float t = static_cast<float>(time);
+  forEachChunk([&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = std::max(begin, first); i < end; ++i) {
+      const float phase = static_cast<float>(i) * 0.37f;
+      state.joint0[i] = 180.0f * std::sin(0.3f * t + phase);
+      state.joint1[i] = 45.0f * std::sin(0.7f * t + 1.3f * phase);
+      state.joint2[i] = 60.0f * std::sin(1.1f * t + 0.7f * phase);
+    }
+  });
+}
+
+void ArmScene::update(float dt) {
+  const std::size_t count = size();
+  forEachChunk([&](std::size_t begin, std::size_t end) {
+    kinematics::forwardBatch(state.joint0.data() + begin, state.joint1.data() + begin, state.joint2.data() + begin,
+                             end - begin, end_x.data() + begin, end_y.data() + begin, end_z.data() + begin);
+    for (std::size_t i = begin; i < end; ++i) {
+      end_x[i] += state.base_x[i];
+      end_z[i] += state.base_z[i];
+    }
+  });
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!grab[i]) {
+      if (held[i] != NO_TARGET) caught[held[i]] = 0;
+      held[i] = NO_TARGET;
+      continue;
+    }
+    const glm::vec3 end = getEndEffectorPosition(i);
+    if (held[i] != NO_TARGET) {
+      // Same rule as a single arm: the target slips out as soon as the tip moved away further than TOLERANCE
+      const glm::vec3 offset = end - getTargetPosition(held[i]);
+      if (glm::dot(offset, offset) > TOLERANCE * TOLERANCE) {
+        caught[held[i]] = 0;
+        held[i] = NO_TARGET;
+      }
+    }
+    if (held[i] == NO_TARGET) held[i] = findFreeTarget(end);
+    if (held[i] == NO_TARGET) continue;
+    const std::uint32_t target = held[i];
+    caught[target] = 1;
+    state.target_x[target] = end.x;
+    state.target_y[target] = end.y;
+    state.target_z[target] = end.z;
+    target_hash.update(target, end);
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!caught[i] && drop[i] && state.target_y[i] > TARGET_HEIGHT / 2) {
+      state.target_y[i] = std::max(state.target_y[i] - DROP_SPEED * dt, TARGET_HEIGHT / 2);
+      target_hash.update(static_cast<std::uint32_t>(i), getTargetPosition(i));
+    }
+  }
+  forEachChunk([&](std::size_t begin, std::size_t end) {
+    collision::checkBatch(state.joint0.data() + begin, state.joint1.data() + begin, state.joint2.data() + begin,
+                          state.base_x.data() + begin, state.base_z.data() + begin, state.target_x.data() + begin,
+                          state.target_y.data() + begin, state.target_z.data() + begin, end - begin,
+                          state.contacts.data() + begin);
+    for (std::size_t i = begin; i < end; ++i) {
+      if (held[i] == i) state.contacts[i] &= static_cast<std::uint8_t>(~collision::TARGET);
+    }
+  });
+}
+
+std::uint32_t ArmScene::findFreeTarget(const glm::vec3& position) const {
+  std::uint32_t nearest = NO_TARGET;
+  float nearest_distance2 = TOLERANCE * TOLERANCE;
+  target_hash.forEachNear(position, [&](std::uint32_t target) {
+    if (caught[target]) return;
+    const float dx = position.x - state.target_x[target], dy = position.y - state.target_y[target],
+                dz = position.z - state.target_z[target];
+    const float distance2 = dx * dx + dy * dy + dz * dz;
+    if (distance2 <= nearest_distance2) {
+      nearest_distance2 = distance2;
+      nearest = target;
+    }
+  });
+  return nearest;
+}
+
+glm::vec3 ArmScene::RenderState::getTargetPosition(std::size_t arm, float alpha) const {
+  return glm::mix(glm::vec3(previous_target_x[arm], previous_target_y[arm], previous_target_z[arm]),
+                  getTargetPosition(arm), alpha);
+}
+
+glm::vec3 ArmScene::RenderState::getCenter() const {
+  const float rows = std::ceil(static_cast<float>(size()) / static_cast<float>(columns));
+  return glm::vec3((static_cast<float>(columns) - 1.0f) * GRID_SPACING / 2, 0.0f, -(rows - 1.0f) * GRID_SPACING / 2);
+}
+
+float ArmScene::RenderState::getExtent() const {
+  return static_cast<float>(columns - 1) * GRID_SPACING + 2.0f * GRID_SPACING;
+}
+
+void ArmScene::RenderState::computePartModels(std::size_t arm, float alpha,
+                                              std::array<glm::mat4, RobotArm::PART_COUNT>& models) const {
+  const float angle0 = glm::mix(previous_joint0[arm], joint0[arm], alpha);
+  const float angle1 = glm::mix(previous_joint1[arm], joint1[arm], alpha);
+  const float angle2 = glm::mix(previous_joint2[arm], joint2[arm], alpha);
+  const glm::mat4 base = glm::translate(glm::mat4(1.0f), glm::vec3(base_x[arm], 0.0f, base_z[arm]));
+  models[RobotArm::BASE] = base * part_shapes[RobotArm::BASE];
+  glm::mat4 frame = glm::translate(base, glm::vec3(0.0f, BASE_HEIGHT, 0.0f));
+  frame = glm::rotate(frame, glm::radians(angle0), glm::vec3(0.0f, 1.0f, 0.0f));
+  models[RobotArm::ARM1] = frame * part_shapes[RobotArm::ARM1];
+  frame = glm::translate(frame, glm::vec3(0.0f, ARM_LEN + JOINT_RADIUS, 0.0f));
+  frame = glm::rotate(frame, glm::radians(angle1), glm::vec3(1.0f, 0.0f, 0.0f));
+  models[RobotArm::JOINT1] = frame * part_shapes[RobotArm::JOINT1];
+  models[RobotArm::ARM2] = glm::translate(frame, glm::vec3(0.0f, JOINT_RADIUS, 0.0f)) * part_shapes[RobotArm::ARM2];
+  frame = glm::translate(frame, glm::vec3(0.0f, kinematics::LINK2_LENGTH, 0.0f));
+  frame = glm::rotate(frame, glm::radians(angle2), glm::vec3(1.0f, 0.0f, 0.0f));
+  models[RobotArm::JOINT2] = frame * part_shapes[RobotArm::JOINT2];
+  models[RobotArm::ARM3] = glm::translate(frame, glm::vec3(0.0f, JOINT_RADIUS, 0.0f)) * part_shapes[RobotArm::ARM3];
+}
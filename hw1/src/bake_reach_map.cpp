@@ -0,0 +1,24 @@
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+#include "reach_map.h"
+
+/// @brief Bake the reachability map of the current arm dimensions, usage: BakeReachMap [FILE]
+/// FILE defaults to reach_map.bin next to the tool, where HW1 looks for it.
+int main(int argc, char** argv) {
+  const std::filesystem::path path = argc > 1 ? argv[1] : ReachMap::getDefaultPath(argv[0]);
+  const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    ReachMap::bake(path, threads);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "Baked " << path.string() << " on " << threads << " threads in " << elapsed.count() << " s" << std::endl;
+  return 0;
+}
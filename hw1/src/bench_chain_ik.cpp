@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "arm_kinematics.h"
+#include "chain_ik.h"
+
+namespace {
+/// @brief Iterations and convergence of a series of solves.
+struct SolveStats {
+  std::uint64_t solves = 0;
+  std::uint64_t converged = 0;
+  std::uint64_t iterations = 0;
+  double seconds = 0.0;
+
+  void add(const ChainIk::Result& result) {
+    ++solves;
+    converged += result.converged ? 1 : 0;
+    iterations += static_cast<std::uint64_t>(result.iterations);
+  }
+  void print(const char* name) const {
+    std::cout << "  " << name << ": " << static_cast<double>(iterations) / solves << " iterations mean, "
+              << 100.0 * static_cast<double>(converged) / solves << "% converged, " << seconds * 1e6 / solves
+              << " us per solve" << std::endl;
+  }
+};
+
+/// @brief Random pose that does not fold arm3 back onto arm2.
+kinematics::IkSolution randomPose(std::mt19937& random) {
+  std::uniform_real_distribution<float> yaw(-180.0f, 180.0f), pitch(-90.0f, 90.0f), bend(-140.0f, 140.0f);
+  return kinematics::IkSolution{yaw(random), pitch(random), bend(random), true};
+}
+}  // namespace
+
+/// @brief Measure ChainIk on the arm from cold and warm starts, usage: BenchChainIk [SOLVES] [SEED]
+int main(int argc, char** argv) {
+  try {
+    const int solves = argc > 1 ? std::stoi(argv[1]) : 100000;
+    const std::uint32_t seed = argc > 2 ? static_cast<std::uint32_t>(std::stoul(argv[2])) : 1;
+    if (solves <= 0) throw std::invalid_argument("SOLVES must be positive");
+    const ChainIk ik = ChainIk::createArm();
+    std::mt19937 random(seed);
+
+    // The generic chain must agree with the closed-form kinematics of the same arm
+    float max_deviation = 0.0f;
+    for (int i = 0; i < solves; ++i) {
+      const kinematics::IkSolution pose = randomPose(random);
+      const float angles[] = {pose.joint0, pose.joint1, pose.joint2};
+      const glm::vec3 offset = ik.forward(angles) - kinematics::forward(pose.joint0, pose.joint1, pose.joint2);
+      max_deviation = std::max(max_deviation, glm::length(offset));
+    }
+
+    // Targets are end effectors of random poses, so every one of them is reachable
+    std::vector<glm::vec3> targets(static_cast<std::size_t>(solves));
+    for (glm::vec3& target : targets) {
+      const kinematics::IkSolution pose = randomPose(random);
+      target = kinematics::forward(pose.joint0, pose.joint1, pose.joint2);
+    }
+    SolveStats cold;
+    auto start = std::chrono::steady_clock::now();
+    for (const glm::vec3& target : targets) {
+      float angles[] = {0.0f, 0.0f, 0.0f};
+      cold.add(ik.solve(target, angles));
+    }
+    cold.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // A target moving like an animated arm's tip at 60 steps per second, each solve starts from the last solution
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+      const float t = static_cast<float>(i) / 60.0f;
+      targets[i] = kinematics::forward(180.0f * std::sin(0.3f * t), 45.0f * std::sin(0.7f * t),
+                                       60.0f * std::sin(1.1f * t) + 30.0f);
+    }
+    SolveStats warm;
+    float angles[] = {0.0f, 0.0f, 0.0f};
+    start = std::chrono::steady_clock::now();
+    for (const glm::vec3& target : targets) warm.add(ik.solve(target, angles));
+    warm.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "ChainIk on the arm, " << solves << " solves each" << std::endl
+              << "  forward: " << max_deviation << " max deviation from kinematics::forward" << std::endl;
+    cold.print("cold start");
+    warm.print("warm start");
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl << "Usage: " << argv[0] << " [SOLVES] [SEED]" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "chain_ik.h"
+#include "kinematic_chain.h"
+
+namespace {
+/// @brief Call fk on every pose repeats times, returns nanoseconds per call and adds the end effectors to checksum.
+template <typename Fk>
+double measure(const std::vector<float>& poses, int repeats, Fk&& fk, glm::vec3& checksum) {
+  const std::size_t count = poses.size() / 3;
+  const auto start = std::chrono::steady_clock::now();
+  for (int repeat = 0; repeat < repeats; ++repeat) {
+    for (std::size_t i = 0; i < count; ++i) checksum += fk(poses.data() + 3 * i);
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return seconds * 1e9 / (static_cast<double>(count) * repeats);
+}
+}  // namespace
+
+/// @brief Compare the unrolled ArmChain with the generic matrix chain, usage: BenchKinematicChain [POSES] [REPEATS]
+int main(int argc, char** argv) {
+  try {
+    const int poses = argc > 1 ? std::stoi(argv[1]) : 4096;
+    const int repeats = argc > 2 ? std::stoi(argv[2]) : 1000;
+    if (poses <= 0 || repeats <= 0) throw std::invalid_argument("arguments must be positive");
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+    std::vector<float> angles(static_cast<std::size_t>(poses) * ArmChain::JOINT_COUNT);
+    for (float& value : angles) value = angle(random);
+
+    // Same chain, once built from the template and once as the runtime fallback for chains loaded from data
+    const ChainIk generic = ArmChain::makeRuntime();
+    // Summing the results keeps the calls from being optimized away
+    glm::vec3 specialized_sum(0.0f), generic_sum(0.0f);
+    const double specialized_ns =
+        measure(angles, repeats, [](const float* pose) { return ArmChain::forward(pose); }, specialized_sum);
+    const double generic_ns =
+        measure(angles, repeats, [&](const float* pose) { return generic.forward(pose); }, generic_sum);
+
+    std::cout << poses << " poses x " << repeats << " repeats" << std::endl
+              << "  ArmChain::forward: " << specialized_ns << " ns per pose" << std::endl
+              << "  ChainIk::forward:  " << generic_ns << " ns per pose (" << generic_ns / specialized_ns
+              << "x slower)" << std::endl
+              << "  checksum difference: " << glm::length(specialized_sum - generic_sum) / repeats << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl << "Usage: " << argv[0] << " [POSES] [REPEATS]" << std::endl;
+    return 1;
+  }
+  return 0;
+}
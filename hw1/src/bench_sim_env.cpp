@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sim_env.h"
+
+namespace {
+/// @brief Distinct random action sets cycled through, so the timed loop does no random number generation.
+constexpr std::size_t ACTION_SETS = 16;
+
+struct ActionPlanes {
+  std::vector<float> joint0, joint1, joint2;
+  std::vector<std::uint8_t> grab, drop;
+};
+
+/// @brief Step envs environments steps times, returns the elapsed seconds.
+double run(std::size_t envs, int steps, std::uint32_t seed) {
+  SimEnv env(envs, seed);
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> delta(-3.0f, 3.0f);
+  std::bernoulli_distribution flag(0.5);
+  std::vector<ActionPlanes> sets(ACTION_SETS);
+  for (ActionPlanes& set : sets) {
+    for (std::size_t i = 0; i < envs; ++i) {
+      set.joint0.push_back(delta(random));
+      set.joint1.push_back(delta(random));
+      set.joint2.push_back(delta(random));
+      set.grab.push_back(flag(random) ? 1 : 0);
+      set.drop.push_back(flag(random) ? 1 : 0);
+    }
+  }
+  const auto start = std::chrono::steady_clock::now();
+  for (int step = 0; step < steps; ++step) {
+    const ActionPlanes& set = sets[static_cast<std::size_t>(step) % ACTION_SETS];
+    env.step(SimEnv::Actions{set.joint0.data(), set.joint1.data(), set.joint2.data(), set.grab.data(),
+                             set.drop.data()},
+             1.0f / 60.0f);
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+/// @brief Measure SimEnv throughput, usage: BenchSimEnv [ENVS_PER_THREAD] [STEPS] [THREADS]
+int main(int argc, char** argv) {
+  try {
+    const std::size_t envs = argc > 1 ? std::stoul(argv[1]) : 4096;
+    const int steps = argc > 2 ? std::stoi(argv[2]) : 2000;
+    const unsigned threads = argc > 3 ? static_cast<unsigned>(std::stoul(argv[3]))
+                                      : std::max(1u, std::thread::hardware_concurrency());
+    if (envs == 0 || steps <= 0 || threads == 0) throw std::invalid_argument("arguments must be positive");
+    // Every thread owns its own environments, nothing is shared while stepping
+    std::vector<double> seconds(threads);
+    std::vector<std::thread> workers;
+    for (unsigned thread = 1; thread < threads; ++thread) {
+      workers.emplace_back([&, thread] { seconds[thread] = run(envs, steps, thread + 1); });
+    }
+    seconds[0] = run(envs, steps, 1);
+    for (std::thread& worker : workers) worker.join();
+
+    const double slowest = *std::max_element(seconds.begin(), seconds.end());
+    const double env_steps = static_cast<double>(envs) * steps;
+    std::cout << threads << " threads x " << envs << " environments x " << steps << " steps" << std::endl
+              << "  " << env_steps * threads / slowest << " environment steps/s total" << std::endl
+              << "  " << env_steps / slowest << " environment steps/s per core" << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl << "Usage: " << argv[0] << " [ENVS_PER_THREAD] [STEPS] [THREADS]" << std::endl;
+    return 1;
+  }
+  return 0;
+}
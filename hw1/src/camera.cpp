@@ -14,37 +14,42 @@ void Camera::initialize(float aspectRatio) {
   updateViewMatrix();
 }
 
-void Camera::move(GLFWwindow* window) {
+CameraInput Camera::pollInput(GLFWwindow* window) {
+  CameraInput input{glm::vec2(0.0f), 0};
+  glm::dvec2 cursor;
+  glfwGetCursorPos(window, &cursor.x, &cursor.y);
+  if (hasCursor) input.cursorDelta = glm::vec2(cursor - lastCursor);
+  lastCursor = cursor;
+  hasCursor = true;
+  if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) input.keys |= CameraInput::FORWARD;
+  if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) input.keys |= CameraInput::BACKWARD;
+  if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) input.keys |= CameraInput::LEFT;
+  if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) input.keys |= CameraInput::RIGHT;
+  return input;
+}
+
+void Camera::move(const CameraInput& input) {
   bool ismoved = false;
   // Mouse part
-  static double lastx = 0, lasty = 0;
-  if (lastx == 0 && lasty == 0) {
-    glfwGetCursorPos(window, &lastx, &lasty);
-  } else {
-    double xpos, ypos;
-    glfwGetCursorPos(window, &xpos, &ypos);
-    float dx = mouseMoveSpeed * static_cast<float>(xpos - lastx);
-    float dy = mouseMoveSpeed * static_cast<float>(lasty - ypos);
-    lastx = xpos;
-    lasty = ypos;
-    if (dx != 0 || dy != 0) {
-      ismoved = true;
-      glm::quat rx(glm::angleAxis(dx, glm::vec3(0, -1, 0)));
-      glm::quat ry(glm::angleAxis(dy, glm::vec3(1, 0, 0)));
-      rotation = rx * rotation * ry;
-    }
+  float dx = mouseMoveSpeed * input.cursorDelta.x;
+  float dy = -mouseMoveSpeed * input.cursorDelta.y;
+  if (dx != 0 || dy != 0) {
+    ismoved = true;
+    glm::quat rx(glm::angleAxis(dx, glm::vec3(0, -1, 0)));
+    glm::quat ry(glm::angleAxis(dy, glm::vec3(1, 0, 0)));
+    rotation = rx * rotation * ry;
   }
   // Keyboard part
-  if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
+  if (input.keys & CameraInput::FORWARD) {
     position += front * keyboardMoveSpeed;
     ismoved = true;
-  } else if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
+  } else if (input.keys & CameraInput::BACKWARD) {
     position -= front * keyboardMoveSpeed;
     ismoved = true;
-  } else if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
+  } else if (input.keys & CameraInput::LEFT) {
     position -= right * keyboardMoveSpeed;
     ismoved = true;
-  } else if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
+  } else if (input.keys & CameraInput::RIGHT) {
     position += right * keyboardMoveSpeed;
     ismoved = true;
   }
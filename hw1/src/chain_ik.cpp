@@ -0,0 +1,72 @@
+#include "chain_ik.h"
+
+#include <stdexcept>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "kinematic_chain.h"
+#include "utils.h"
+
+ChainIk::ChainIk(const JointSpec* joint_specs, std::size_t count, const glm::vec3& tip_offset)
+    : joints(), joint_count(count), tip(tip_offset) {
+  if (count > MAX_JOINTS) {
+    THROW_EXCEPTION(std::length_error, "ChainIk supports at most " + std::to_string(MAX_JOINTS) + " joints");
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    joints[i] = JointSpec{joint_specs[i].offset, glm::normalize(joint_specs[i].axis)};
+  }
+}
+
+ChainIk ChainIk::createArm() { return ArmChain::makeRuntime(); }
+
+glm::vec3 ChainIk::computeFrames(const float* angles_radian, std::array<glm::vec3, MAX_JOINTS>& pivots,
+                                 std::array<glm::vec3, MAX_JOINTS>& axes) const {
+  glm::mat4 frame(1.0f);
+  for (std::size_t i = 0; i < joint_count; ++i) {
+    frame = glm::translate(frame, joints[i].offset);
+    pivots[i] = glm::vec3(frame[3]);
+    axes[i] = glm::mat3(frame) * joints[i].axis;
+    frame = glm::rotate(frame, angles_radian[i], joints[i].axis);
+  }
+  return glm::vec3(frame * glm::vec4(tip, 1.0f));
+}
+
+glm::vec3 ChainIk::forward(const float* angles_degree) const {
+  std::array<float, MAX_JOINTS> radians;
+  std::array<glm::vec3, MAX_JOINTS> pivots, axes;
+  for (std::size_t i = 0; i < joint_count; ++i) radians[i] = glm::radians(angles_degree[i]);
+  return computeFrames(radians.data(), pivots, axes);
+}
+
+ChainIk::Result ChainIk::solve(const glm::vec3& target, float* angles_degree, const Settings& settings) const {
+  std::array<float, MAX_JOINTS> radians;
+  std::array<glm::vec3, MAX_JOINTS> pivots, axes, jacobian;
+  for (std::size_t i = 0; i < joint_count; ++i) radians[i] = glm::radians(angles_degree[i]);
+
+  Result result{0, 0.0f, false};
+  const float damping2 = settings.damping * settings.damping;
+  while (true) {
+    const glm::vec3 end = computeFrames(radians.data(), pivots, axes);
+    glm::vec3 error = target - end;
+    result.error = glm::length(error);
+    if (result.error <= settings.tolerance) {
+      result.converged = true;
+      break;
+    }
+    if (result.iterations == settings.max_iterations) break;
+    ++result.iterations;
+    if (result.error > settings.max_step) error *= settings.max_step / result.error;
+
+    // Column i is how the end effector moves per radian of joint i
+    glm::mat3 jjt(0.0f);
+    for (std::size_t i = 0; i < joint_count; ++i) {
+      jacobian[i] = glm::cross(axes[i], end - pivots[i]);
+      jjt += glm::outerProduct(jacobian[i], jacobian[i]);
+    }
+    jjt += glm::mat3(damping2);
+    const glm::vec3 weights = glm::inverse(jjt) * error;
+    for (std::size_t i = 0; i < joint_count; ++i) radians[i] += glm::dot(jacobian[i], weights);
+  }
+  for (std::size_t i = 0; i < joint_count; ++i) angles_degree[i] = glm::degrees(radians[i]);
+  return result;
+}
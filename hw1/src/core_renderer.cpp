@@ -0,0 +1,152 @@
+#include "core_renderer.h"
+
+#include <cstddef>
+
+#include "gl_state.h"
+
+namespace {
+constexpr GLuint POSITION_LOCATION = 0;
+constexpr GLuint NORMAL_LOCATION = 1;
+constexpr GLuint MODEL_LOCATION = 2;
+constexpr GLuint NORMAL_MODEL_LOCATION = 6;
+constexpr GLuint COLOR_LOCATION = 9;
+constexpr GLuint FRAME_BINDING = 0;
+
+constexpr const char* VERTEX_SHADER = R"glsl(
+#version 330 core
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in mat4 instance_model;
+layout(location = 6) in mat3 instance_normal_model;
+layout(location = 9) in vec3 instance_color;
+
+layout(std140) uniform Frame {
+  mat4 view;
+  mat4 projection;
+  vec4 light_position;
+  vec4 light_ambient;
+  vec4 light_diffuse;
+  vec4 global_ambient;
+  int lighting;
+};
+
+out vec3 color;
+
+void main() {
+  vec4 view_position = view * (instance_model * vec4(position, 1.0));
+  gl_Position = projection * view_position;
+  if (lighting == 0) {
+    color = instance_color;
+    return;
+  }
+  vec3 view_normal = normalize(mat3(view) * (instance_normal_model * normal));
+  vec3 light_direction = normalize(light_position.xyz - view_position.xyz * light_position.w);
+  float diffuse = max(dot(view_normal, light_direction), 0.0);
+  vec3 light = (global_ambient + light_ambient + light_diffuse * diffuse).rgb;
+  color = clamp(instance_color * light, 0.0, 1.0);
+}
+)glsl";
+
+constexpr const char* FRAGMENT_SHADER = R"glsl(
+#version 330 core
+in vec3 color;
+out vec4 frag_color;
+
+void main() { frag_color = vec4(color, 1.0); }
+)glsl";
+}  // namespace
+
+CoreRenderer::CoreRenderer() : program(VERTEX_SHADER, FRAGMENT_SHADER) {
+  GLuint block_index = glGetUniformBlockIndex(program.getHandle(), "Frame");
+  glUniformBlockBinding(program.getHandle(), block_index, FRAME_BINDING);
+
+  glGenBuffers(1, &uniform_buffer);
+  glBindBuffer(GL_UNIFORM_BUFFER, uniform_buffer);
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+  glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BINDING, uniform_buffer);
+
+  glGenBuffers(1, &instance_buffer);
+}
+
+CoreRenderer::~CoreRenderer() {
+  GLState::bindVertexArray(0);
+  for (const auto& [vbo, vao] : vertex_arrays) glDeleteVertexArrays(1, &vao);
+  glDeleteBuffers(1, &instance_buffer);
+  glDeleteBuffers(1, &uniform_buffer);
+}
+
+void CoreRenderer::beginFrame(const glm::mat4& view, const glm::mat4& projection, const Light& light,
+                              bool lighting) {
+  FrameUniforms uniforms{};
+  uniforms.view = view;
+  uniforms.projection = projection;
+  uniforms.light_position = view * light.position;
+  uniforms.light_ambient = light.ambient;
+  uniforms.light_diffuse = light.diffuse;
+  // Same as the fixed-function GL_LIGHT_MODEL_AMBIENT default
+  uniforms.global_ambient = glm::vec4(0.2f, 0.2f, 0.2f, 1.0f);
+  uniforms.lighting = lighting ? 1 : 0;
+  glBindBuffer(GL_UNIFORM_BUFFER, uniform_buffer);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &uniforms);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void CoreRenderer::draw(const Mesh& mesh, const std::vector<Instance>& instances) {
+  if (instances.empty()) return;
+  // Orphan last frame's storage so the driver never waits for its draw to finish.
+  GLsizeiptr size = static_cast<GLsizeiptr>(instances.size() * sizeof(Instance));
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  if (size > instance_buffer_size) {
+    glBufferData(GL_ARRAY_BUFFER, size, instances.data(), GL_STREAM_DRAW);
+    instance_buffer_size = size;
+  } else {
+    glBufferData(GL_ARRAY_BUFFER, instance_buffer_size, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, instances.data());
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  // Program and vertex array stay bound between draws, nothing else uses them in core profile.
+  program.use();
+  GLState::bindVertexArray(getVertexArray(mesh));
+  glDrawElementsInstanced(GL_TRIANGLES, mesh.getIndexCount(), GL_UNSIGNED_INT, nullptr,
+                          static_cast<GLsizei>(instances.size()));
+}
+
+GLuint CoreRenderer::getVertexArray(const Mesh& mesh) {
+  // Meshes are created once at startup, so their vertex buffer name identifies them.
+  auto found = vertex_arrays.find(mesh.getVertexBuffer());
+  if (found != vertex_arrays.end()) return found->second;
+
+  GLuint vao = 0;
+  glGenVertexArrays(1, &vao);
+  GLState::bindVertexArray(vao);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.getIndexBuffer());
+
+  glBindBuffer(GL_ARRAY_BUFFER, mesh.getVertexBuffer());
+  glEnableVertexAttribArray(POSITION_LOCATION);
+  glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<const void*>(offsetof(Vertex, position)));
+  glEnableVertexAttribArray(NORMAL_LOCATION);
+  glVertexAttribPointer(NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                        reinterpret_cast<const void*>(offsetof(Vertex, normal)));
+
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  auto setInstanceAttribute = [](GLuint location, GLint components, std::size_t offset) {
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(location, components, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<const void*>(offset));
+    glVertexAttribDivisor(location, 1);
+  };
+  for (GLuint i = 0; i < 4; ++i) {
+    setInstanceAttribute(MODEL_LOCATION + i, 4, offsetof(Instance, model) + i * sizeof(glm::vec4));
+  }
+  for (GLuint i = 0; i < 3; ++i) {
+    setInstanceAttribute(NORMAL_MODEL_LOCATION + i, 3, offsetof(Instance, normal_model) + i * sizeof(glm::vec3));
+  }
+  setInstanceAttribute(COLOR_LOCATION, 3, offsetof(Instance, color));
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  vertex_arrays.emplace(mesh.getVertexBuffer(), vao);
+  return vao;
+}
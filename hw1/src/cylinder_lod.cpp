@@ -0,0 +1,26 @@
+#include "cylinder_lod.h"
+
+#include <algorithm>
+#include <cmath>
+
+void CylinderLod::setCamera(const glm::mat4& view, const glm::mat4& projection, int viewport_height) {
+  view_matrix = view;
+  // projection[1][1] is cot(fov / 2), which maps a view-space height at depth 1 to NDC.
+  pixels_per_unit = projection[1][1] * viewport_height * 0.5f;
+}
+
+std::size_t CylinderLod::selectLevel(const glm::mat4& model) const {
+  // The ring lies in the local xz plane, its center at half height.
+  float radius = std::max(glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[2])));
+  glm::vec4 center = view_matrix * (model * glm::vec4(0.0f, 0.5f, 0.0f, 1.0f));
+  float depth = -center.z;
+  // Too close to estimate, or behind the camera: keep full detail.
+  if (depth <= radius) return LEVEL_COUNT - 1;
+  float radius_pixels = radius * pixels_per_unit / depth;
+  // A polygon with n sides deviates from its circle by r * (1 - cos(pi / n)) ~= r * pi^2 / (2 n^2).
+  float needed = utils::PI<float>() * std::sqrt(radius_pixels / (2.0f * MAX_ERROR_PIXELS));
+  for (std::size_t level = 0; level < LEVEL_COUNT; ++level) {
+    if (static_cast<float>(SEGMENTS[level]) >= needed) return level;
+  }
+  return LEVEL_COUNT - 1;
+}
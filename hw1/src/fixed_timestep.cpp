@@ -0,0 +1,25 @@
+#include "fixed_timestep.h"
+
+#include <cmath>
+
+FixedTimestep::FixedTimestep(double step_seconds, int max_steps_per_frame)
+    : step(step_seconds), max_steps(max_steps_per_frame) {}
+
+int FixedTimestep::advance(double now) {
+  if (last < 0.0) {
+    last = now;
+    return 0;
+  }
+  accumulator += now - last;
+  last = now;
+  int steps = static_cast<int>(std::floor(accumulator / step));
+  if (steps > max_steps) {
+    // Keep the fraction so interpolation stays continuous, only whole steps are thrown away
+    dropped += (steps - max_steps) * step;
+    accumulator -= (steps - max_steps) * step;
+    steps = max_steps;
+  }
+  accumulator -= steps * step;
+  time += steps * step;
+  return steps;
+}
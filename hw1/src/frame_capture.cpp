@@ -0,0 +1,128 @@
+#include "frame_capture.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+constexpr int BYTES_PER_PIXEL = 4;
+}  // namespace
+
+FrameCapture::FrameCapture(const std::filesystem::path& output_directory) : directory(output_directory) {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  if (error) {
+    THROW_EXCEPTION(std::runtime_error,
+                    "Cannot create capture directory " + directory.string() + ": " + error.message());
+  }
+  for (auto& slot : slots) glGenBuffers(1, &slot.buffer);
+  writer = std::thread(&FrameCapture::writerLoop, this);
+}
+
+FrameCapture::~FrameCapture() {
+  // Oldest frames first, so files are written in order
+  for (int i = 0; i < RING_SIZE; ++i) drain(slots[(next_slot + i) % RING_SIZE]);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  frame_ready.notify_one();
+  writer.join();
+  for (auto& slot : slots) glDeleteBuffers(1, &slot.buffer);
+}
+
+void FrameCapture::capture(int width, int height) {
+  Slot& slot = slots[next_slot];
+  next_slot = (next_slot + 1) % RING_SIZE;
+  // This slot was read RING_SIZE frames ago, the transfer is done and mapping does not wait
+  drain(slot);
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  if (slot.width != width || slot.height != height) {
+    glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(width) * height * BYTES_PER_PIXEL, nullptr,
+                 GL_STREAM_READ);
+    slot.width = width;
+    slot.height = height;
+  }
+  // With a pack buffer bound, glReadPixels only schedules the copy and returns immediately
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  slot.frame = frame_index++;
+  slot.pending = true;
+}
+
+void FrameCapture::drain(Slot& slot) {
+  if (!slot.pending) return;
+  slot.pending = false;
+
+  std::vector<unsigned char> pixels;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    // Back pressure only kicks in if the disk cannot keep up
+    frame_written.wait(lock, [this] { return queue.size() < MAX_PENDING_FRAMES; });
+    if (!free_buffers.empty()) {
+      pixels = std::move(free_buffers.back());
+      free_buffers.pop_back();
+    }
+  }
+  std::size_t size = static_cast<std::size_t>(slot.width) * slot.height * BYTES_PER_PIXEL;
+  pixels.resize(size);
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  const void* mapped = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+  if (mapped != nullptr) {
+    std::memcpy(pixels.data(), mapped, size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  if (mapped == nullptr) {
+    std::cerr << "Failed to map capture buffer, frame " << slot.frame << " is skipped." << std::endl;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(Frame{slot.frame, slot.width, slot.height, std::move(pixels)});
+  }
+  frame_ready.notify_one();
+}
+
+void FrameCapture::writerLoop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    frame_ready.wait(lock, [this] { return stopping || !queue.empty(); });
+    if (queue.empty()) return;
+    Frame frame = std::move(queue.front());
+    queue.pop_front();
+    lock.unlock();
+    frame_written.notify_one();
+    writeFrame(frame);
+    lock.lock();
+    free_buffers.push_back(std::move(frame.pixels));
+  }
+}
+
+void FrameCapture::writeFrame(const Frame& frame) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "frame_%06llu.ppm", static_cast<unsigned long long>(frame.index));
+  std::FILE* file = std::fopen((directory / name).string().c_str(), "wb");
+  if (file == nullptr) {
+    std::cerr << "Cannot write " << (directory / name).string() << std::endl;
+    return;
+  }
+  std::fprintf(file, "P6\n%d %d\n255\n", frame.width, frame.height);
+  // OpenGL rows start at the bottom, PPM rows at the top
+  std::vector<unsigned char> row(static_cast<std::size_t>(frame.width) * 3);
+  for (int y = frame.height - 1; y >= 0; --y) {
+    const unsigned char* source = frame.pixels.data() + static_cast<std::size_t>(y) * frame.width * BYTES_PER_PIXEL;
+    for (int x = 0; x < frame.width; ++x) {
+      row[x * 3 + 0] = source[x * BYTES_PER_PIXEL + 0];
+      row[x * 3 + 1] = source[x * BYTES_PER_PIXEL + 1];
+      row[x * 3 + 2] = source[x * BYTES_PER_PIXEL + 2];
+    }
+    std::fwrite(row.data(), 1, row.size(), file);
+  }
+  std::fclose(file);
+}
@@ -0,0 +1,59 @@
+#include "frame_pacer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include <GLFW/glfw3.h>
+
+FramePacer::FramePacer(double target_fps) : period(target_fps > 0.0 ? 1.0 / target_fps : 0.0) {}
+
+VsyncMode FramePacer::applyVsync(VsyncMode mode) {
+  if (mode == VsyncMode::ADAPTIVE && !glfwExtensionSupported("WGL_EXT_swap_control_tear") &&
+      !glfwExtensionSupported("GLX_EXT_swap_control_tear")) {
+    std::cerr << "Adaptive vsync is not supported, using vsync on." << std::endl;
+    mode = VsyncMode::ON;
+  }
+  switch (mode) {
+    case VsyncMode::OFF:
+      glfwSwapInterval(0);
+      break;
+    case VsyncMode::ON:
+      glfwSwapInterval(1);
+      break;
+    case VsyncMode::ADAPTIVE:
+      // Negative interval enables late swap tearing
+      glfwSwapInterval(-1);
+      break;
+  }
+  return mode;
+}
+
+void FramePacer::endFrame() {
+  if (period > 0.0) {
+    double now = glfwGetTime();
+    // Fell behind by more than a frame: restart from now instead of rushing to catch up
+    deadline = (deadline < 0.0 || now - deadline > period) ? now : deadline + period;
+    double remaining = deadline - now;
+    if (remaining > SPIN_THRESHOLD) {
+      std::this_thread::sleep_for(std::chrono::duration<double>(remaining - SPIN_THRESHOLD));
+    }
+    while (glfwGetTime() < deadline) {
+    }
+  }
+
+  double now = glfwGetTime();
+  if (last_frame_end >= 0.0) {
+    // Welford's online mean and variance
+    double frame_time = (now - last_frame_end) * 1000.0;
+    ++stats.frames;
+    double delta = frame_time - stats.mean;
+    stats.mean += delta / static_cast<double>(stats.frames);
+    squared_deviation += delta * (frame_time - stats.mean);
+    stats.jitter = std::sqrt(squared_deviation / static_cast<double>(stats.frames));
+    stats.max = std::max(stats.max, frame_time);
+  }
+  last_frame_end = now;
+}
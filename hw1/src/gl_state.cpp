@@ -0,0 +1,83 @@
+#include "gl_state.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+std::unordered_map<GLenum, std::optional<bool>> GLState::capabilities;
+std::unordered_map<std::uint32_t, std::optional<glm::vec4>> GLState::light_parameters;
+std::optional<GLenum> GLState::depth_function;
+std::optional<glm::vec4> GLState::clear_color;
+std::optional<GLdouble> GLState::clear_depth;
+std::optional<GLenum> GLState::shade_model;
+std::optional<glm::uvec2> GLState::color_material;
+std::optional<GLuint> GLState::program;
+std::optional<GLuint> GLState::vertex_array;
+GLState::Stats GLState::frame_stats;
+GLState::Stats GLState::total_stats;
+
+void GLState::setCapability(GLenum capability, bool enabled) {
+  if (!update(capabilities[capability], enabled)) return;
+  if (enabled) {
+    glEnable(capability);
+  } else {
+    glDisable(capability);
+  }
+}
+
+void GLState::depthFunc(GLenum function) {
+  if (update(depth_function, function)) glDepthFunc(function);
+}
+
+void GLState::clearColor(const glm::vec4& color) {
+  if (update(clear_color, color)) glClearColor(color.r, color.g, color.b, color.a);
+}
+
+void GLState::clearDepth(GLdouble depth) {
+  if (update(clear_depth, depth)) glClearDepth(depth);
+}
+
+void GLState::shadeModel(GLenum mode) {
+  if (update(shade_model, mode)) glShadeModel(mode);
+}
+
+void GLState::colorMaterial(GLenum face, GLenum mode) {
+  if (update(color_material, glm::uvec2(face, mode))) glColorMaterial(face, mode);
+}
+
+void GLState::lightfv(GLenum light, GLenum name, const glm::vec4& value) {
+  // Position and direction are transformed by the current modelview matrix, the same value can mean a new state.
+  if (name == GL_POSITION || name == GL_SPOT_DIRECTION) {
+    ++frame_stats.issued;
+    ++total_stats.issued;
+    glLightfv(light, name, glm::value_ptr(value));
+    return;
+  }
+  // Light enums fit in 16 bits (GL_LIGHT0 = 0x4000, GL_SPOT_CUTOFF = 0x1206)
+  std::uint32_t key = (static_cast<std::uint32_t>(light) << 16) | (name & 0xFFFFu);
+  if (update(light_parameters[key], value)) glLightfv(light, name, glm::value_ptr(value));
+}
+
+void GLState::useProgram(GLuint handle) {
+  if (update(program, handle)) glUseProgram(handle);
+}
+
+void GLState::bindVertexArray(GLuint handle) {
+  if (update(vertex_array, handle)) glBindVertexArray(handle);
+}
+
+void GLState::invalidate() {
+  capabilities.clear();
+  light_parameters.clear();
+  depth_function.reset();
+  clear_color.reset();
+  clear_depth.reset();
+  shade_model.reset();
+  color_material.reset();
+  program.reset();
+  vertex_array.reset();
+}
+
+GLState::Stats GLState::newFrame() {
+  Stats last = frame_stats;
+  frame_stats = Stats();
+  return last;
+}
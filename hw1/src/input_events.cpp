@@ -0,0 +1,103 @@
+#include "input_events.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "arm_collision.h"
+#include "arm_kinematics.h"
+
+void InputLatency::add(InputEvent::Clock::time_point event, InputEvent::Clock::time_point now) {
+  const double ms = std::chrono::duration<double, std::milli>(now - event).count();
+  ++events;
+  total_ms += ms;
+  max_ms = std::max(max_ms, ms);
+}
+
+namespace {
+/// @brief Inverse kinematics for target, the elbow up branch if elbow down collides and it does not.
+kinematics::IkSolution solveCatchPose(const glm::vec3& target) {
+  kinematics::IkSolution solution = kinematics::inverse(target);
+  auto collides = [&](const kinematics::IkSolution& pose) {
+    const std::uint8_t contacts = collision::checkPose(pose.joint0, pose.joint1, pose.joint2, target);
+    return (contacts & ~collision::TARGET) != collision::NONE;
+  };
+  if (solution.reachable && collides(solution)) {
+    const kinematics::IkSolution elbow_up = kinematics::inverse(target, true);
+    if (!collides(elbow_up)) solution = elbow_up;
+  }
+  return solution;
+}
+}  // namespace
+
+void ArmControl::apply(const InputEvent& event, const glm::vec3& target) {
+  switch (event.type) {
+    case InputEvent::Type::ROTATE:
+      joints[event.joint] += event.degrees;
+      path.clear();
+      break;
+    case InputEvent::Type::GRAB:
+      grab = true;
+      break;
+    case InputEvent::Type::RELEASE:
+      grab = false;
+      break;
+    case InputEvent::Type::TOGGLE_DROP:
+      printf(drop ? "down disable\n" : "down enable\n");
+      drop = !drop;
+      break;
+    case InputEvent::Type::REACH: {
+      // Snap the arm onto the target with inverse kinematics
+      const kinematics::IkSolution solution = solveCatchPose(target);
+      if (solution.reachable) {
+        joints = glm::vec3(solution.joint0, solution.joint1, solution.joint2);
+        path.clear();
+      } else {
+        printf("target out of reach\n");
+      }
+      break;
+    }
+    case InputEvent::Type::PLAN: {
+      if (!planner) break;
+      const kinematics::IkSolution solution = solveCatchPose(target);
+      if (!solution.reachable) {
+        printf("target out of reach\n");
+        break;
+      }
+      MotionPlanner::Result result =
+          planner->plan(joints, glm::vec3(solution.joint0, solution.joint1, solution.joint2));
+      if (result.found) {
+        printf("planned %zu waypoints in %.2f ms\n", result.path.size(), result.milliseconds);
+        path = std::move(result.path);
+        next_waypoint = 1;
+      } else {
+        printf("no collision-free path found in %.2f ms\n", result.milliseconds);
+      }
+      break;
+    }
+  }
+}
+
+void ArmControl::drain(InputQueue& queue, const glm::vec3& target, InputLatency& latency) {
+  InputEvent event;
+  while (queue.tryPop(event)) {
+    latency.add(event.time, InputEvent::Clock::now());
+    apply(event, target);
+  }
+}
+
+void ArmControl::follow(float dt) {
+  float budget = PATH_SPEED * dt;
+  while (next_waypoint < path.size() && budget > 0.0f) {
+    const glm::vec3 offset = path[next_waypoint] - joints;
+    const float distance = glm::length(offset);
+    if (distance <= budget) {
+      joints = path[next_waypoint++];
+      budget -= distance;
+    } else {
+      joints += offset * (budget / distance);
+      budget = 0.0f;
+    }
+  }
+  if (next_waypoint >= path.size()) path.clear();
+}
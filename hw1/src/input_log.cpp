@@ -0,0 +1,94 @@
+#include "input_log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace input_log {
+namespace {
+constexpr char MAGIC[4] = {'H', 'W', 'I', 'L'};
+constexpr std::uint32_t VERSION = 1;
+
+template <typename T>
+void append(std::vector<char>& buffer, const T& value) {
+  const std::size_t offset = buffer.size();
+  buffer.resize(offset + sizeof(T));
+  std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+/// @return Whether all of value could be read.
+template <typename T>
+bool read(std::ifstream& file, T& value) {
+  return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+}  // namespace
+
+Header makeHeader(int arms, double sim_rate) {
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.arms = static_cast<std::uint32_t>(arms);
+  header.sim_rate = sim_rate;
+  return header;
+}
+
+Recorder::Recorder(const std::filesystem::path& path, const Header& header)
+    : file(path, std::ios::binary | std::ios::trunc) {
+  file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+  if (!file) THROW_EXCEPTION(std::runtime_error, "Failed to write " + path.string());
+}
+
+void Recorder::recordKey(int key, int action) {
+  keys.push_back(KeyAction{static_cast<std::int16_t>(key), static_cast<std::uint8_t>(action)});
+}
+
+void Recorder::writeFrame(double time, const CameraInput& camera) {
+  // A frame cannot hold more callbacks than its count field, the rest go into the next one
+  const std::size_t count = std::min<std::size_t>(keys.size(), std::numeric_limits<std::uint16_t>::max());
+  buffer.clear();
+  append(buffer, time);
+  append(buffer, camera.cursorDelta.x);
+  append(buffer, camera.cursorDelta.y);
+  append(buffer, camera.keys);
+  append(buffer, static_cast<std::uint16_t>(count));
+  for (std::size_t i = 0; i < count; ++i) {
+    append(buffer, keys[i].key);
+    append(buffer, keys[i].action);
+  }
+  keys.erase(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(count));
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+Player::Player(const std::filesystem::path& path) : file(path, std::ios::binary) {
+  if (!read(file, header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+    THROW_EXCEPTION(std::runtime_error, path.string() + " is not an input log of version " + std::to_string(VERSION));
+  }
+  // The header replaces --arms and --sim-rate, so it has to pass the same checks
+  if (header.arms < 1 || header.arms > static_cast<std::uint32_t>(std::numeric_limits<int>::max())) {
+    THROW_EXCEPTION(std::runtime_error, path.string() + " has an invalid arm count " + std::to_string(header.arms));
+  }
+  if (!std::isfinite(header.sim_rate) || !(header.sim_rate > 0.0)) {
+    THROW_EXCEPTION(std::runtime_error, path.string() + " has an invalid simulation rate");
+  }
+}
+
+bool Player::next(Frame& frame) {
+  if (!read(file, frame.time)) return false;
+  std::uint16_t count = 0;
+  if (!read(file, frame.camera.cursorDelta.x) || !read(file, frame.camera.cursorDelta.y) ||
+      !read(file, frame.camera.keys) || !read(file, count)) {
+    THROW_EXCEPTION(std::runtime_error, "Input log ends inside a frame");
+  }
+  frame.keys.resize(count);
+  for (KeyAction& key : frame.keys) {
+    if (!read(file, key.key) || !read(file, key.action)) {
+      THROW_EXCEPTION(std::runtime_error, "Input log ends inside a frame");
+    }
+  }
+  return true;
+}
+}  // namespace input_log
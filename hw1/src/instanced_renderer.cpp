@@ -0,0 +1,157 @@
+#include "instanced_renderer.h"
+
+#include <cstddef>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include "gl_state.h"
+
+namespace {
+// Start from 8 to stay clear of the conventional attributes aliased by some drivers (gl_Vertex, gl_Normal, gl_Color).
+constexpr GLuint MODEL_LOCATION = 8;
+constexpr GLuint NORMAL_MODEL_LOCATION = 12;
+constexpr GLuint COLOR_LOCATION = 15;
+
+constexpr const char* VERTEX_SHADER = R"glsl(
+#version 120
+attribute vec4 instance_model0;
+attribute vec4 instance_model1;
+attribute vec4 instance_model2;
+attribute vec4 instance_model3;
+attribute vec3 instance_normal0;
+attribute vec3 instance_normal1;
+attribute vec3 instance_normal2;
+attribute vec3 instance_color;
+uniform bool lighting;
+varying vec4 color;
+
+void main() {
+  mat4 model = mat4(instance_model0, instance_model1, instance_model2, instance_model3);
+  vec4 view_position = gl_ModelViewMatrix * (model * gl_Vertex);
+  gl_Position = gl_ProjectionMatrix * view_position;
+  if (!lighting) {
+    color = vec4(instance_color, 1.0);
+    return;
+  }
+  // Same terms as GL_LIGHT0 with GL_COLOR_MATERIAL on ambient and diffuse
+  mat3 normal_model = mat3(instance_normal0, instance_normal1, instance_normal2);
+  vec3 normal = normalize(gl_NormalMatrix * (normal_model * gl_Normal));
+  vec4 light_position = gl_LightSource[0].position;
+  vec3 light_direction = normalize(light_position.xyz - view_position.xyz * light_position.w);
+  float diffuse = max(dot(normal, light_direction), 0.0);
+  vec3 light = (gl_LightModel.ambient + gl_LightSource[0].ambient + gl_LightSource[0].diffuse * diffuse).rgb;
+  color = vec4(clamp(instance_color * light, 0.0, 1.0), 1.0);
+}
+)glsl";
+
+constexpr const char* FRAGMENT_SHADER = R"glsl(
+#version 120
+varying vec4 color;
+
+void main() { gl_FragColor = color; }
+)glsl";
+}  // namespace
+
+InstancedRenderer::InstancedRenderer() : supported(isSupported()) {
+  if (!supported) return;
+  program = ShaderProgram(VERTEX_SHADER, FRAGMENT_SHADER,
+                          {{MODEL_LOCATION + 0, "instance_model0"},
+                           {MODEL_LOCATION + 1, "instance_model1"},
+                           {MODEL_LOCATION + 2, "instance_model2"},
+                           {MODEL_LOCATION + 3, "instance_model3"},
+                           {NORMAL_MODEL_LOCATION + 0, "instance_normal0"},
+                           {NORMAL_MODEL_LOCATION + 1, "instance_normal1"},
+                           {NORMAL_MODEL_LOCATION + 2, "instance_normal2"},
+                           {COLOR_LOCATION, "instance_color"}});
+  lighting_location = program.getUniformLocation("lighting");
+  glGenBuffers(1, &instance_buffer);
+}
+
+InstancedRenderer::~InstancedRenderer() {
+  if (instance_buffer != 0) glDeleteBuffers(1, &instance_buffer);
+}
+
+bool InstancedRenderer::isSupported() {
+  bool draw_instanced = GLAD_GL_VERSION_3_1 || GLAD_GL_ARB_draw_instanced;
+  bool instanced_arrays = GLAD_GL_VERSION_3_3 || GLAD_GL_ARB_instanced_arrays;
+  return GLAD_GL_VERSION_2_0 && draw_instanced && instanced_arrays;
+}
+
+void InstancedRenderer::beginFrame(const glm::mat4& view, const glm::mat4& projection, const Light& light,
+                                   bool lighting) {
+  // Projection Matrix
+  glMatrixMode(GL_PROJECTION);
+  glLoadMatrixf(glm::value_ptr(projection));
+  // ModelView Matrix
+  glMatrixMode(GL_MODELVIEW);
+  glLoadMatrixf(glm::value_ptr(view));
+  lighting_enabled = lighting;
+  if (!lighting) {
+    GLState::disable(GL_LIGHTING);
+    return;
+  }
+  // enable lighting, unchanged state is dropped by GLState
+  GLState::enable(GL_LIGHTING);
+  GLState::shadeModel(GL_SMOOTH);
+  GLState::enable(GL_COLOR_MATERIAL);
+  GLState::colorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
+  GLState::enable(GL_NORMALIZE);
+  // set light property, position is transformed by the view matrix loaded above
+  GLState::enable(GL_LIGHT0);
+  GLState::lightfv(GL_LIGHT0, GL_POSITION, light.position);
+  GLState::lightfv(GL_LIGHT0, GL_DIFFUSE, light.diffuse);
+  GLState::lightfv(GL_LIGHT0, GL_SPECULAR, light.specular);
+  GLState::lightfv(GL_LIGHT0, GL_AMBIENT, light.ambient);
+}
+
+void InstancedRenderer::draw(const Mesh& mesh, const std::vector<Instance>& instances) {
+  if (instances.empty()) return;
+  if (!supported) {
+    drawFallback(mesh, instances);
+    return;
+  }
+  // Orphan last frame's storage so the driver never waits for its draw to finish.
+  GLsizeiptr size = static_cast<GLsizeiptr>(instances.size() * sizeof(Instance));
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  if (size > instance_buffer_size) {
+    glBufferData(GL_ARRAY_BUFFER, size, instances.data(), GL_STREAM_DRAW);
+    instance_buffer_size = size;
+  } else {
+    glBufferData(GL_ARRAY_BUFFER, instance_buffer_size, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, instances.data());
+  }
+  auto setAttribute = [](GLuint location, GLint components, std::size_t offset) {
+    glEnableVertexAttribArray(location);
+    glVertexAttribPointer(location, components, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                          reinterpret_cast<const void*>(offset));
+    glVertexAttribDivisor(location, 1);
+  };
+  for (GLuint i = 0; i < 4; ++i) {
+    setAttribute(MODEL_LOCATION + i, 4, offsetof(Instance, model) + i * sizeof(glm::vec4));
+  }
+  for (GLuint i = 0; i < 3; ++i) {
+    setAttribute(NORMAL_MODEL_LOCATION + i, 3, offsetof(Instance, normal_model) + i * sizeof(glm::vec3));
+  }
+  setAttribute(COLOR_LOCATION, 3, offsetof(Instance, color));
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  program.use();
+  glUniform1i(lighting_location, lighting_enabled);
+  mesh.drawInstanced(static_cast<GLsizei>(instances.size()));
+  GLState::useProgram(0);
+
+  for (GLuint location = MODEL_LOCATION; location <= COLOR_LOCATION; ++location) {
+    glVertexAttribDivisor(location, 0);
+    glDisableVertexAttribArray(location);
+  }
+}
+
+void InstancedRenderer::drawFallback(const Mesh& mesh, const std::vector<Instance>& instances) const {
+  for (const auto& instance : instances) {
+    glPushMatrix();
+    glMultMatrixf(glm::value_ptr(instance.model));
+    glColor3f(instance.color.r, instance.color.g, instance.color.b);
+    mesh.draw();
+    glPopMatrix();
+  }
+}
@@ -0,0 +1,162 @@
+#include "job_system.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Set on worker threads, every other thread submits through the shared deque
+thread_local const JobSystem* local_system = nullptr;
+thread_local std::size_t local_queue = 0;
+}  // namespace
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> body, std::initializer_list<TaskId> dependencies) {
+  const TaskId id = tasks.size();
+  for (TaskId dependency : dependencies) {
+    if (dependency >= id) THROW_EXCEPTION(std::invalid_argument, "Unknown dependency " + std::to_string(dependency));
+  }
+  Task& task = tasks.emplace_back();
+  task.body = std::move(body);
+  task.dependency_count = dependencies.size();
+  for (TaskId dependency : dependencies) tasks[dependency].successors.push_back(id);
+  return id;
+}
+
+struct JobSystem::GraphRun {
+  JobSystem* system;
+  TaskGraph* graph;
+  Counter counter;
+};
+
+JobSystem::JobSystem(unsigned worker_count)
+    : queues(std::make_unique<Queue[]>(worker_count + 1)), queue_count(worker_count + 1) {
+  workers.reserve(worker_count);
+  for (unsigned i = 0; i < worker_count; ++i) workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread& worker : workers) worker.join();
+}
+
+void JobSystem::run(TaskGraph& graph) {
+  if (graph.size() == 0) return;
+  GraphRun run{this, &graph, {}};
+  // Every task counts down once when it finishes, successors are queued before that
+  run.counter.pending.store(graph.size(), std::memory_order_relaxed);
+  for (TaskGraph::Task& task : graph.tasks) task.waiting.store(task.dependency_count, std::memory_order_relaxed);
+  for (TaskGraph::TaskId id = 0; id < graph.size(); ++id) {
+    if (graph.tasks[id].dependency_count == 0) push(Job{runTask, &run, id, id + 1, NO_SPLIT, &run.counter});
+  }
+  waitFor(run.counter);
+}
+
+void JobSystem::runTask(void* context, std::size_t task, std::size_t) {
+  GraphRun& run = *static_cast<GraphRun*>(context);
+  std::deque<TaskGraph::Task>& tasks = run.graph->tasks;
+  tasks[task].body();
+  for (TaskGraph::TaskId successor : tasks[task].successors) {
+    if (tasks[successor].waiting.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      run.system->push(Job{runTask, context, successor, successor + 1, NO_SPLIT, &run.counter});
+    }
+  }
+}
+
+void JobSystem::submitAndWait(Job job) {
+  Counter counter;
+  counter.pending.store(1, std::memory_order_relaxed);
+  job.counter = &counter;
+  execute(job);
+  waitFor(counter);
+}
+
+void JobSystem::push(const Job& job) {
+  {
+    Queue& queue = queues[getLocalQueue()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(job);
+  }
+  // Pairs with workerLoop: either the worker sees the new epoch or this sees it sleeping
+  epoch.fetch_add(1, std::memory_order_seq_cst);
+  if (sleeping.load(std::memory_order_seq_cst) > 0) {
+    // Taking the lock keeps the notification from falling between a worker's check and its wait
+    { std::lock_guard<std::mutex> lock(sleep_mutex); }
+    wake.notify_one();
+  }
+}
+
+bool JobSystem::tryTake(Job& job, const Counter* only) {
+  auto matches = [only](const Job& queued) { return only == nullptr || queued.counter == only; };
+  const std::size_t own = getLocalQueue();
+  {
+    Queue& queue = queues[own];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    const auto found = std::find_if(queue.jobs.rbegin(), queue.jobs.rend(), matches);
+    if (found != queue.jobs.rend()) {
+      job = *found;
+      queue.jobs.erase(std::next(found).base());
+      return true;
+    }
+  }
+  for (std::size_t offset = 1; offset < queue_count; ++offset) {
+    Queue& victim = queues[(own + offset) % queue_count];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    const auto found = std::find_if(victim.jobs.begin(), victim.jobs.end(), matches);
+    if (found != victim.jobs.end()) {
+      job = *found;
+      victim.jobs.erase(found);
+      return true;
+    }
+  }
+  return false;
+}
+
+void JobSystem::execute(Job job) {
+  while (job.end - job.begin > job.grain) {
+    const std::size_t middle = job.begin + (job.end - job.begin) / 2;
+    job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+    push(Job{job.invoke, job.context, middle, job.end, job.grain, job.counter});
+    job.end = middle;
+  }
+  job.invoke(job.context, job.begin, job.end);
+  job.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::waitFor(const Counter& counter) {
+  // Outside threads share queues[0], without the filter they would pick up each other's jobs
+  const Counter* only = local_system == this ? nullptr : &counter;
+  while (counter.pending.load(std::memory_order_acquire) != 0) {
+    Job job;
+    if (tryTake(job, only)) {
+      execute(job);
+    } else {
+      // The rest is running on other threads
+      std::this_thread::yield();
+    }
+  }
+}
+
+void JobSystem::workerLoop(std::size_t queue) {
+  local_system = this;
+  local_queue = queue;
+  while (true) {
+    const std::uint64_t seen = epoch.load(std::memory_order_seq_cst);
+    Job job;
+    if (tryTake(job, nullptr)) {
+      execute(job);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    sleeping.fetch_add(1, std::memory_order_seq_cst);
+    wake.wait(lock, [&] { return stopping || epoch.load(std::memory_order_seq_cst) != seen; });
+    sleeping.fetch_sub(1, std::memory_order_seq_cst);
+    if (stopping) return;
+  }
+}
+
+std::size_t JobSystem::getLocalQueue() const { return local_system == this ? local_queue : 0; }
@@ -0,0 +1,28 @@
+#include "lod_instances.h"
+
+#include <algorithm>
+
+std::size_t LodInstances::getChunkCount(const JobSystem& jobs, std::size_t count) {
+  return std::max<std::size_t>(1, std::min(jobs.size() * CHUNKS_PER_THREAD, count / MIN_CHUNK_ITEMS));
+}
+
+void LodInstances::merge(JobSystem& jobs, std::size_t chunk_count) {
+  offsets.resize(chunk_count);
+  for (std::size_t level = 0; level < CylinderLod::LEVEL_COUNT; ++level) {
+    std::size_t offset = 0;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      offsets[chunk][level] = offset;
+      offset += chunks[chunk][level].size();
+    }
+    // Sizes barely change from frame to frame, so this seldom has to initialize new elements
+    lists[level].resize(offset);
+  }
+  jobs.parallelFor(chunk_count, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t chunk = first; chunk < last; ++chunk) {
+      for (std::size_t level = 0; level < CylinderLod::LEVEL_COUNT; ++level) {
+        std::copy(chunks[chunk][level].begin(), chunks[chunk][level].end(),
+                  lists[level].begin() + static_cast<std::ptrdiff_t>(offsets[chunk][level]));
+      }
+    }
+  });
+}
@@ -1,5 +1,10 @@
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <GLFW/glfw3.h>
@@ -7,15 +12,36 @@
 #include <glad/gl.h>
 #undef GLAD_GL_IMPLEMENTATION
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
 
+#include "arm_collision.h"
+#include "arm_dimensions.h"
+#include "arm_scene.h"
 #include "camera.h"
+#include "core_renderer.h"
+#include "cylinder_lod.h"
+#include "fixed_timestep.h"
+#include "frame_capture.h"
+#include "frame_pacer.h"
+#include "gl_state.h"
+#include "input_events.h"
+#include "input_log.h"
+#include "instanced_renderer.h"
+#include "job_system.h"
+#include "lod_instances.h"
+#include "mesh.h"
+#include "motion_planner.h"
 #include "opengl_context.h"
+#include "options.h"
+#include "reach_map.h"
+#include "renderer.h"
+#include "robot_arm.h"
+#include "simulation.h"
 #include "utils.h"
 
-#define ANGEL_TO_RADIAN(x) (float)((x)*M_PI / 180.0f) 
-#define RADIAN_TO_ANGEL(x) (float)((x)*180.0f / M_PI) 
-
 #define CIRCLE_SEGMENT 64
+static_assert(CylinderLod::SEGMENTS.back() == CIRCLE_SEGMENT, "Finest cylinder LOD should match CIRCLE_SEGMENT");
 
 /* Key definition 
 #define GLFW_KEY_U 85
@@ -24,35 +50,38 @@
 #define GLFW_KEY_K 75
 #define GLFW_KEY_O 79
 #define GLFW_KEY_L 76
+#define GLFW_KEY_R 82
 #define GLFW_KEY_SPACE 32 */
 
-/* Components size definition */
-#define ARM_LEN 1.0f
-#define ARM_RADIUS 0.05f
-#define ARM_DIAMETER (ARM_RADIUS * 2)
-#define JOINT_RADIUS 0.05f
-#define JOINT_DIAMETER (JOINT_RADIUS * 2)
-#define JOINT_WIDTH 0.1f
-#define BASE_RADIUS 0.5f
-#define BASEE_DIAMETER (BASE_RADIUS * 2)
-#define BASE_HEIGHT 0.1f
-#define TARGET_RADIUS 0.05f
-#define TARGET_DIAMETER (TARGET_RADIUS * 2)
-#define TARGET_HEIGHT 0.1f
-#define ROTATE_SPEED 0.3f 
-#define CATCH_POSITION_OFFSET 0.1f
-#define TOLERANCE 0.1f
-
 #define RED 0.905f, 0.298f, 0.235f
 #define BLUE 0.203f, 0.596f, 0.858f
 #define GREEN 0.18f, 0.8f, 0.443f
+#define GRAY 0.5f, 0.5f, 0.5f
+
+const glm::vec3 PART_COLORS[RobotArm::PART_COUNT] = {
+    glm::vec3(GREEN), glm::vec3(BLUE), glm::vec3(GREEN), glm::vec3(BLUE), glm::vec3(GREEN), glm::vec3(BLUE),
+};
+
+/// @return Color of a part, parts of an arm that collides with something are tinted red.
+glm::vec3 getPartColor(RobotArm::Part part, std::uint8_t contacts) {
+  return contacts == collision::NONE ? PART_COLORS[part] : glm::mix(PART_COLORS[part], glm::vec3(RED), 0.6f);
+}
 
-float joint0_degree = 0;
-float joint1_degree = 0;
-float joint2_degree = 0;
 glm::vec3 target_pos(0.0f, 0.05f, 1.0f);
-bool space_down = false;
-bool g_down = false;
+// Filled by keyCallback, drained by whichever thread runs the simulation
+InputQueue input_events;
+std::uint64_t dropped_input_events = 0;
+// Set while recording, keyCallback logs every key it gets
+input_log::Recorder* input_recorder = nullptr;
+// Set while replaying, keys then only come from the log
+bool replaying_input = false;
+
+/// @brief Simulated state of the single arm, kept for the last two steps to interpolate rendering.
+struct ArmState {
+  glm::vec3 joints;
+  glm::vec3 target;
+  std::uint8_t contacts;
+};
 
 void resizeCallback(GLFWwindow* window, int width, int height) {
   OpenGLContext::framebufferResizeCallback(window, width, height);
@@ -62,7 +91,8 @@ void resizeCallback(GLFWwindow* window, int width, int height) {
   }
 }
 
-void keyCallback(GLFWwindow* window, int key, int, int action, int) {
+/// @brief Act on one key callback, whether it came from the window or from a replayed log.
+void handleKey(GLFWwindow* window, int key, int action) {
   // There are three actions: press, release, hold(repeat)
   if (action == GLFW_REPEAT) return;
   // Press ESC to close the window.
@@ -80,61 +110,75 @@ void keyCallback(GLFWwindow* window, int key, int, int action, int) {
    *       You should finish your robotic arm first.
    *       Otherwise you will spend a lot of time debugging this with a black screen.
    */
+  InputEvent event{InputEvent::Type::ROTATE, 0, 0.0f, InputEvent::Clock::now()};
   switch (key) {
     case GLFW_KEY_U:
-      joint0_degree += 10 * ROTATE_SPEED;
+      event.joint = 0;
+      event.degrees = 10 * ROTATE_SPEED;
       break;
     case GLFW_KEY_J:
-      joint0_degree -= 10 * ROTATE_SPEED;
+      event.joint = 0;
+      event.degrees = -10 * ROTATE_SPEED;
       break;
     case GLFW_KEY_I:
-      joint1_degree -= 10 * ROTATE_SPEED;
+      event.joint = 1;
+      event.degrees = -10 * ROTATE_SPEED;
       break;
     case GLFW_KEY_K:
-      joint1_degree += 10 * ROTATE_SPEED;
+      event.joint = 1;
+      event.degrees = 10 * ROTATE_SPEED;
       break;
     case GLFW_KEY_O:
-      joint2_degree -= 10 * ROTATE_SPEED;
+      event.joint = 2;
+      event.degrees = -10 * ROTATE_SPEED;
       break;
     case GLFW_KEY_L:
-      joint2_degree += 10 * ROTATE_SPEED;
+      event.joint = 2;
+      event.degrees = 10 * ROTATE_SPEED;
+      break;
+    case GLFW_KEY_R:
+      if (action != GLFW_PRESS) return;
+      event.type = InputEvent::Type::REACH;
+      break;
+    case GLFW_KEY_P:
+      // Plan a collision-free path onto the target
+      if (action != GLFW_PRESS) return;
+      event.type = InputEvent::Type::PLAN;
       break;
     case GLFW_KEY_G:
-      if (action == GLFW_RELEASE) {
-        if (g_down) {
-          printf("down disable\n");
-        } else {
-          printf("down enable\n");
-        }
-        g_down = !g_down;
-      }
+      if (action != GLFW_RELEASE) return;
+      event.type = InputEvent::Type::TOGGLE_DROP;
       break;
     case GLFW_KEY_SPACE:
-      switch (action) {
-        case GLFW_PRESS:
-          space_down = true;
-          break;
-        case GLFW_RELEASE:
-          space_down = false;
-          break;
-        default:
-          break;
-      }
+      event.type = action == GLFW_PRESS ? InputEvent::Type::GRAB : InputEvent::Type::RELEASE;
       break;
     default:
-      break;
+      return;
   }
+  // The simulation consumes events at its own rate, a full queue means it stalled
+  if (!input_events.tryPush(event)) ++dropped_input_events;
+}
+
+void keyCallback(GLFWwindow* window, int key, int, int action, int) {
+  // A replay can still be cut short with ESC
+  if (replaying_input && key != GLFW_KEY_ESCAPE) return;
+  if (input_recorder) input_recorder->recordKey(key, action);
+  handleKey(window, key, action);
 }
 
-void initOpenGL() {
+void initOpenGL(const Options& options) {
   // Initialize OpenGL context, details are wrapped in class.
+  if (options.core_profile) {
 #ifdef __APPLE__
-  // MacOS need explicit request legacy support
-  OpenGLContext::createContext(21, GLFW_OPENGL_ANY_PROFILE);
+    // MacOS only provides up to 4.1 core profile
+    OpenGLContext::createContext(41, GLFW_OPENGL_CORE_PROFILE, options.headless);
 #else
-  OpenGLContext::createContext(21, GLFW_OPENGL_ANY_PROFILE);
-//  OpenGLContext::createContext(43, GLFW_OPENGL_COMPAT_PROFILE);
+    OpenGLContext::createContext(43, GLFW_OPENGL_CORE_PROFILE, options.headless);
 #endif
+  } else {
+    // MacOS need explicit request legacy support
+    OpenGLContext::createContext(21, GLFW_OPENGL_ANY_PROFILE, options.headless);
+  }
   GLFWwindow* window = OpenGLContext::getWindow();
   /* TODO#0: Change window title to "HW1 - `your student id`"
    *         Ex. HW1 - 311550000 
@@ -142,7 +186,10 @@ void initOpenGL() {
   glfwSetWindowTitle(window, "HW1 - 311551144");
   glfwSetKeyCallback(window, keyCallback);
   glfwSetFramebufferSizeCallback(window, resizeCallback);
-  glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+  if (!options.headless) {
+    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    FramePacer::applyVsync(options.vsync);
+  }
 #ifndef NDEBUG
   OpenGLContext::printSystemInfo();
   // This is useful if you want to debug your OpenGL API calls.
@@ -150,93 +197,35 @@ void initOpenGL() {
 #endif
 }
 
-void drawUnitCylinder() {
-  /* TODO#2-1: Render a unit cylinder
-   * Hint:
-   *       glBegin/glEnd (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glBegin.xml)
-   *       glColor3f (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glBegin.xml)
-   *       glVertex3f (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glVertex.xml)
-   *       glNormal (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glNormal.xml)
-   *       glScalef (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glScale.xml)
-   * Note:
-   *       You can refer to ppt "Draw Cylinder" page and `CIRCLE_SEGMENT`
-   *       You should set normal for lighting
-   */
-
-  float innerAngle = 360.f;
-  float innerRadian;
-
-  glPushMatrix();
-  glTranslatef(target_pos.x, target_pos.y, target_pos.z);
-  glScalef(TARGET_DIAMETER/2, TARGET_HEIGHT, TARGET_DIAMETER/2);
-  glBegin(GL_TRIANGLE_STRIP);
-  glColor3f(RED);
-  for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-    innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-    float z = cos(innerRadian);
-    float x = sin(innerRadian);
-    innerRadian = ANGEL_TO_RADIAN(innerAngle * (i - 0.5) / CIRCLE_SEGMENT);
-    float nz = cos(innerRadian);
-    float nx = sin(innerRadian);
-    glNormal3f(nx, 0.0f, nz);
-    glVertex3f(x, 0.5f, z);
-    glVertex3f(x, -0.5f, z);
-  }
-  glEnd();
-  glPopMatrix();
-
-  glPushMatrix();
-  glTranslatef(target_pos.x, target_pos.y, target_pos.z);
-  glScalef(TARGET_DIAMETER / 2, TARGET_HEIGHT, TARGET_DIAMETER / 2);
-  glBegin(GL_POLYGON);
-  glNormal3f(0.0f, 1.0f, 0.0f);
-  for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-    innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-    float z = cos(innerRadian);
-    float x = sin(innerRadian);
-    glVertex3f(x, 0.5f, z);
+int main(int argc, char** argv) {
+  Options options;
+  try {
+    options = Options::parse(argc, argv);
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what() << std::endl;
+    Options::printUsage(argv[0]);
+    return 1;
   }
-  glEnd();
-  glPopMatrix();
-
-  glPushMatrix();
-  glTranslatef(target_pos.x, target_pos.y , target_pos.z);
-  glScalef(TARGET_DIAMETER / 2, TARGET_HEIGHT, TARGET_DIAMETER / 2);
-  glBegin(GL_POLYGON);
-  glNormal3f(0.0f, -1.0f, 0.0f);
-  for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-    innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-    float z = cos(innerRadian);
-    float x = sin(innerRadian);
-    glVertex3f(x, -0.5f, z);
+  std::unique_ptr<input_log::Player> input_player;
+  std::unique_ptr<input_log::Recorder> recorder;
+  try {
+    if (!options.replay_path.empty()) {
+      input_player = std::make_unique<input_log::Player>(options.replay_path);
+      // The recorded run's settings decide what the same input does
+      options.arms = static_cast<int>(input_player->getHeader().arms);
+      options.sim_rate = input_player->getHeader().sim_rate;
+      replaying_input = true;
+    }
+    if (!options.record_path.empty()) {
+      recorder = std::make_unique<input_log::Recorder>(options.record_path,
+                                                       input_log::makeHeader(options.arms, options.sim_rate));
+      input_recorder = recorder.get();
+    }
+  } catch (const std::runtime_error& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
   }
-  glEnd();
-  glPopMatrix();
-}
-
-void light() {
-  GLfloat light_specular[] = {0.6, 0.6, 0.6, 1};
-  GLfloat light_diffuse[] = {0.6, 0.6, 0.6, 1};
-  GLfloat light_ambient[] = {0.4, 0.4, 0.4, 1};
-  GLfloat light_position[] = {50.0, 75.0, 80.0, 1.0};
-  // z buffer enable
-  glEnable(GL_DEPTH_TEST);
-  // enable lighting
-  glEnable(GL_LIGHTING);
-  glShadeModel(GL_SMOOTH);
-  glEnable(GL_COLOR_MATERIAL);
-  glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-  glEnable(GL_NORMALIZE);
-  // set light property
-  glEnable(GL_LIGHT0);
-  glLightfv(GL_LIGHT0, GL_POSITION, light_position);
-  glLightfv(GL_LIGHT0, GL_DIFFUSE, light_diffuse);
-  glLightfv(GL_LIGHT0, GL_SPECULAR, light_specular);
-  glLightfv(GL_LIGHT0, GL_AMBIENT, light_ambient);
-}
-
-int main() {
-  initOpenGL();
+  initOpenGL(options);
   GLFWwindow* window = OpenGLContext::getWindow();
 
   // Init Camera helper
@@ -244,32 +233,95 @@ int main() {
   camera.initialize(OpenGLContext::getAspectRatio());
   // Store camera as glfw global variable for callbasks use
   glfwSetWindowUserPointer(window, &camera);
-
-  // Main rendering loop
-  while (!glfwWindowShouldClose(window)) {
-    // Polling events.
-    glfwPollEvents();
+  // Geometry is uploaded once and shared by every part
+  CylinderLod cylinder_lod;
+  Mesh board = Mesh::createUnitPlane();
+  std::unique_ptr<Renderer> renderer;
+  if (options.core_profile) {
+    renderer = std::make_unique<CoreRenderer>();
+  } else {
+    renderer = std::make_unique<InstancedRenderer>();
+  }
+  const Light light;
+  RobotArm arm;
+  // Stress scene with many arms, arm 0 replaces the single keyboard-driven arm
+  std::unique_ptr<ArmScene> scene;
+  // Frame work, path planning and the per-arm passes of the scene are spread over all cores
+  JobSystem jobs(std::max(1u, std::thread::hardware_concurrency()) - 1);
+  MotionPlanner planner(jobs);
+  // Or simulate the scene on its own thread, a single arm then becomes a scene of one
+  std::unique_ptr<Simulation> simulation;
+  if (options.threaded) {
+    simulation = std::make_unique<Simulation>(options.arms, 1.0 / options.sim_rate, input_events, &planner, &jobs);
+  } else if (options.arms > 1) {
+    scene = std::make_unique<ArmScene>(options.arms, &jobs);
+  }
+  // All cylinders of a frame are gathered here, then drawn with one call per detail level
+  LodInstances cylinder_instances(cylinder_lod);
+  // Baked by the build once per set of arm dimensions, here it is only mapped
+  std::unique_ptr<ReachMap> reach_map;
+  if (!ReachMap::isCurrent(options.reach_map_path)) {
+    std::cerr << "Reach map " << options.reach_map_path << " is missing or baked for other arm dimensions, run "
+              << "BakeReachMap to create it. Unreachable targets are not marked." << std::endl;
+  } else {
+    try {
+      reach_map = std::make_unique<ReachMap>(options.reach_map_path);
+    } catch (const std::exception& e) {
+      std::cerr << "Reach map disabled: " << e.what() << std::endl;
+    }
+  }
+  // Targets the arm standing at base cannot get to are drawn gray
+  auto addTarget = [&](LodInstances::Sink& sink, const glm::vec3& position, const glm::vec3& base) {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), position - glm::vec3(0.0f, TARGET_HEIGHT / 2, 0.0f));
+    const bool reachable = !reach_map || reach_map->isReachable(position - base);
+    sink.add(glm::scale(model, glm::vec3(TARGET_RADIUS, TARGET_HEIGHT, TARGET_RADIUS)),
+             reachable ? glm::vec3(RED) : glm::vec3(GRAY));
+  };
+  glm::mat4 board_model = glm::scale(glm::mat4(1.0f), glm::vec3(3.0f, 1.0f, 3.0f));
+  if (options.arms > 1) {
+    const ArmScene::RenderState& layout = simulation ? simulation->acquire().scene : scene->getRenderState();
+    const float half_extent = layout.getExtent() / 2;
+    board_model = glm::scale(glm::translate(glm::mat4(1.0f), layout.getCenter()),
+                             glm::vec3(half_extent, 1.0f, half_extent));
+  }
+  std::vector<Instance> board_instances{Instance::create(board_model, glm::vec3(1.0f, 1.0f, 1.0f))};
+
+  std::unique_ptr<FrameCapture> frame_capture;
+  if (!options.capture_directory.empty()) frame_capture = std::make_unique<FrameCapture>(options.capture_directory);
+
+  FixedTimestep timestep(1.0 / options.sim_rate);
+  // Arm 0 input when simulating on this thread
+  ArmControl control;
+  control.planner = &planner;
+  InputLatency input_latency;
+  ArmState current_arm_state{control.joints, target_pos, collision::NONE};
+  ArmState previous_arm_state = current_arm_state;
+  FramePacer frame_pacer(options.fps);
+  std::uint64_t frame_count = 0;
+  // GL state calls of the last finished frame and the most elided in one frame
+  GLState::Stats gl_frame_stats;
+  std::uint64_t gl_max_elided = 0;
+  const double start_time = glfwGetTime();
+  input_log::Frame logged_frame;
+  // Frame state, set on this thread before the frame graph runs or by its tasks
+  double frame_time = 0.0;
+  CameraInput camera_input{glm::vec2(0.0f), 0};
+  glm::mat4 view(1.0f), projection(1.0f);
+  // Scene to draw this frame, nullptr draws the single arm
+  const ArmScene::RenderState* visible_scene = nullptr;
+  const Simulation::Snapshot* snapshot = nullptr;
+  float alpha = 0.0f;
+  // CPU work of a frame: camera and simulation are independent, the instances need both. GL calls stay on this
+  // thread and only start once the whole graph has finished.
+  TaskGraph frame_graph;
+  const TaskGraph::TaskId camera_task = frame_graph.add([&] {
     // Update camera position and view
-    camera.move(window);
-    // GL_XXX_BIT can simply "OR" together to use.
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    /// TO DO Enable DepthTest
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LEQUAL);
-    // Projection Matrix
-    glMatrixMode(GL_PROJECTION);
-    glLoadMatrixf(camera.getProjectionMatrix());
-    // ModelView Matrix
-    glMatrixMode(GL_MODELVIEW);
-    glLoadMatrixf(camera.getViewMatrix());
-
-#ifndef DISABLE_LIGHT   
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-    glClearDepth(1.0f);
-    light();
-#endif
-
+    camera.move(camera_input);
+    view = glm::make_mat4(camera.getViewMatrix());
+    projection = glm::make_mat4(camera.getProjectionMatrix());
+    cylinder_lod.setCamera(view, projection, OpenGLContext::getHeight());
+  });
+  const TaskGraph::TaskId simulate_task = frame_graph.add([&] {
     /* TODO#4-2: Update joint degrees
      *       1. Finish keyCallback to detect key events
      *       2. Update jointx_degree if the correspond key is pressed
@@ -289,412 +341,202 @@ int main() {
      *       You might use `ANGEL_TO_RADIAN`
      *       and refer to `CATCH_POSITION_OFFSET` and `TOLERANCE`
      */
-    glm::vec4 arm_endpoint(0.0f, 0.0f, 0.0f, 1.0f);
-    glm::mat4 trasformMatrix_arm_endpoint(1.0f);
-    
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, BASE_HEIGHT, 0.0f));
-    trasformMatrix_arm_endpoint = glm::rotate(trasformMatrix_arm_endpoint, ANGEL_TO_RADIAN(joint0_degree), glm::vec3(0.0f, 1.0f, 0.0f));
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, ARM_LEN, 0.0f));
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, JOINT_RADIUS, 0.0f));
-    trasformMatrix_arm_endpoint = glm::rotate(trasformMatrix_arm_endpoint, ANGEL_TO_RADIAN(joint1_degree), glm::vec3(1.0f, 0.0f, 0.0f));
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, JOINT_RADIUS, 0.0f));
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, ARM_LEN, 0.0f));
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, JOINT_RADIUS, 0.0f));
-    trasformMatrix_arm_endpoint = glm::rotate(trasformMatrix_arm_endpoint, ANGEL_TO_RADIAN(joint2_degree), glm::vec3(1.0f, 0.0f, 0.0f));
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, JOINT_RADIUS, 0.0f));
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, ARM_LEN, 0.0f));
-    trasformMatrix_arm_endpoint = glm::translate(trasformMatrix_arm_endpoint, glm::vec3(0.0f, CATCH_POSITION_OFFSET, 0.0f));
-    
-    arm_endpoint = trasformMatrix_arm_endpoint * arm_endpoint;
-    float distance_target = powf(arm_endpoint.x - target_pos.x, 2.0f);
-    distance_target += powf(arm_endpoint.y - target_pos.y, 2.0f);
-    distance_target += powf(arm_endpoint.z - target_pos.z, 2.0f);
-    distance_target = sqrtf(distance_target);
-    if (space_down && distance_target <= TOLERANCE) 
-    {
-      target_pos = glm::vec3(arm_endpoint.x, arm_endpoint.y, arm_endpoint.z);
-    } else if (g_down && target_pos.y > 0) {
-      target_pos.y = (target_pos.y - 0.005f < TARGET_HEIGHT / 2) ? TARGET_HEIGHT / 2 : target_pos.y - 0.005f;
-    }
-
-
-    // Render a white board
-    glPushMatrix();
-    glScalef(3, 1, 3);
-    glBegin(GL_TRIANGLE_STRIP);
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glNormal3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(-1.0f, 0.0f, -1.0f);
-    glVertex3f(-1.0f, 0.0f, 1.0f);
-    glVertex3f(1.0f, 0.0f, -1.0f);
-    glVertex3f(1.0f, 0.0f, 1.0f);
-    glEnd();
-    glPopMatrix();
-    drawUnitCylinder();
-    /* TODO#2: Render a cylinder at target_pos
-     *       1. Translate to target_pos
-     *       2. Setup vertex color
-     *       3. Setup cylinder scale
-     *       4. Call drawUnitCylinder
-     * Hint: 
-     *       glTranslatef (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glTranslate.xml)
-     *       glColor3f (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glColor.xml)
-     *       glScalef (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glScale.xml)
-     * Note:
-     *       The coordinates of the cylinder are `target_pos`
-     *       The cylinder's size can refer to `TARGET_RADIUS`, `TARGET_DIAMETER` and `TARGET_DIAMETER`
-     *       The cylinder's color can refer to `RED`
-     */
-
-    /* TODO#3: Render the robotic arm
-     *       1. Render the base
-     *       2. Translate to top of the base
-     *       3. Render an arm
-     *       4. Translate to top of the arm
-     *       5. Render the joint
-     *       6. Translate and rotate to top of the join
-     *       7. Repeat step 3-6
-     * Hint:
-     *       glPushMatrix/glPopMatrix (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glPushMatrix.xml)
-     *       glRotatef (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glRotate.xml)
-     * Note:
-     *       The size of every component can refer to `Components size definition` section
-     *       Rotate degree for joints are `joint0_degree`, `joint1_degree` and `joint2_degree`
-     *       You may implement drawBase, drawArm and drawJoin first
-     */
-
-    float innerAngle = 360.f;
-    float innerRadian;
-
-    //BASE==============================================================
-    glPushMatrix();
-    glScalef(BASEE_DIAMETER / 2, BASE_HEIGHT, BASEE_DIAMETER / 2);
-    glBegin(GL_TRIANGLE_STRIP);
-    glColor3f(GREEN);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-        innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-        float z = cos(innerRadian);
-        float x = sin(innerRadian);
-        innerRadian = ANGEL_TO_RADIAN(innerAngle * (i - 0.5) / CIRCLE_SEGMENT);
-        float nz = cos(innerRadian);
-        float nx = sin(innerRadian);
-        glNormal3f(nx, 0.0f, nz);
-        glVertex3f(x, 1.0f, z);
-        glVertex3f(x, 0.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glScalef(BASEE_DIAMETER / 2, BASE_HEIGHT, BASEE_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(0.0f, 1.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-        innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-        float z = cos(innerRadian);
-        float x = sin(innerRadian);
-        glVertex3f(x, 1.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glScalef(BASEE_DIAMETER / 2, BASE_HEIGHT, BASEE_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(0.0f, -1.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-        innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-        float z = cos(innerRadian);
-        float x = sin(innerRadian);
-        glVertex3f(x, 0.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    // Arm1==============================================================
-    glPushMatrix();
-    glTranslatef(0.0f, BASE_HEIGHT, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER/ 2);
-    glBegin(GL_TRIANGLE_STRIP);
-    glColor3f(BLUE);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float x = sin(innerRadian);
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * (i - 0.5) / CIRCLE_SEGMENT);
-      float nz = cos(innerRadian);
-      float nx = sin(innerRadian);
-      glNormal3f(nx, 0.0f, nz);
-      glVertex3f(x, 1.0f, z);
-      glVertex3f(x, 0.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(0.0f, BASE_HEIGHT, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(0.0f, 1.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float x = sin(innerRadian);
-      glVertex3f(x, 1.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(0.0f, BASE_HEIGHT, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(0.0f, -1.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float x = sin(innerRadian);
-      glVertex3f(x, 0.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    // Joint1==============================================================
-    glPushMatrix();
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint0_degree, 0, 1, 0);
-    glScalef(JOINT_WIDTH, JOINT_DIAMETER / 2, JOINT_DIAMETER / 2);
-    glBegin(GL_TRIANGLE_STRIP);
-    glColor3f(GREEN);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float y = sin(innerRadian);
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * (i - 0.5) / CIRCLE_SEGMENT);
-      float nz = cos(innerRadian);
-      float ny = sin(innerRadian);
-      glNormal3f(0.0f, ny, nz);
-      glVertex3f(-0.5f, y, z);
-      glVertex3f(0.5f, y, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint0_degree, 0, 1, 0);
-    glScalef(JOINT_WIDTH, JOINT_DIAMETER / 2, JOINT_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(1.0f, 0.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float y = cos(innerRadian);
-      float z = sin(innerRadian);
-      glVertex3f(0.5f, y, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint0_degree, 0, 1, 0);
-    glScalef(JOINT_WIDTH, JOINT_DIAMETER / 2, JOINT_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(-1.0f, 0.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float y = sin(innerRadian);
-      glVertex3f(-0.5f, y, z);
+    if (simulation) {
+      // Input events reach the simulation thread through input_events
+      alpha = simulation->getAlpha(*snapshot);
+      return;
     }
-    glEnd();
-    glPopMatrix();
-
-    // Arm2==============================================================
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, JOINT_RADIUS, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER / 2);
-    glBegin(GL_TRIANGLE_STRIP);
-    glColor3f(BLUE);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float x = sin(innerRadian);
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * (i - 0.5) / CIRCLE_SEGMENT);
-      float nz = cos(innerRadian);
-      float nx = sin(innerRadian);
-      glNormal3f(nx, 0.0f, nz);
-      glVertex3f(x, 1.0f, z);
-      glVertex3f(x, 0.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, JOINT_RADIUS, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(0.0f, 1.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float x = sin(innerRadian);
-      glVertex3f(x, 1.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, JOINT_RADIUS, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(0.0f, -1.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float x = cos(innerRadian);
-      float z = sin(innerRadian);
-      glVertex3f(x, 0.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    // Joint2==============================================================
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, ARM_LEN + JOINT_DIAMETER, 0.0f);
-    glRotatef(joint2_degree, 1, 0, 0);
-    glScalef(JOINT_WIDTH, JOINT_DIAMETER / 2, JOINT_DIAMETER / 2);
-    glBegin(GL_TRIANGLE_STRIP);
-    glColor3f(GREEN);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float y = sin(innerRadian);
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * (i - 0.5) / CIRCLE_SEGMENT);
-      float nz = cos(innerRadian);
-      float ny = sin(innerRadian);
-      glNormal3f(0.0f, ny, nz);
-      glVertex3f(-0.5f, y, z);
-      glVertex3f(0.5f, y, z);
+    // Simulation advances in fixed steps, rendering interpolates between the last two of them
+    const int steps = timestep.advance(frame_time);
+    const float dt = static_cast<float>(timestep.getStep());
+    for (int step = 0; step < steps; ++step) {
+      control.drain(input_events, scene ? scene->getTargetPosition(0) : target_pos, input_latency);
+      control.follow(dt);
+      if (scene) {
+        scene->beginStep();
+        scene->setJointAngles(0, control.joints.x, control.joints.y, control.joints.z);
+        scene->setGrip(0, control.grab, control.drop);
+        scene->animate(timestep.getTime() - (steps - 1 - step) * timestep.getStep());
+        scene->update(dt);
+        continue;
+      }
+      previous_arm_state = current_arm_state;
+      arm.setJointAngles(control.joints.x, control.joints.y, control.joints.z);
+      arm.update();
+      glm::vec3 arm_endpoint = arm.getEndEffectorPosition();
+      const glm::vec3 offset = arm_endpoint - target_pos;
+      const bool caught = control.grab && glm::dot(offset, offset) <= TOLERANCE * TOLERANCE;
+      if (caught) 
+      {
+        target_pos = arm_endpoint;
+      } else if (control.drop && target_pos.y > 0) {
+        target_pos.y = std::max(target_pos.y - DROP_SPEED * dt, TARGET_HEIGHT / 2);
+      }
+      std::uint8_t contacts = collision::checkPose(control.joints.x, control.joints.y, control.joints.z, target_pos);
+      if (caught) contacts &= static_cast<std::uint8_t>(~collision::TARGET);
+      current_arm_state = ArmState{control.joints, target_pos, contacts};
     }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, ARM_LEN + JOINT_DIAMETER, 0.0f);
-    glRotatef(joint2_degree, 1, 0, 0);
-    glScalef(JOINT_WIDTH, JOINT_DIAMETER / 2, JOINT_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(1.0f, 0.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float y = cos(innerRadian);
-      float z = sin(innerRadian);
-      glVertex3f(0.5f, y, z);
+    alpha = timestep.getAlpha();
+  });
+  frame_graph.add(
+      [&] {
+        if (!visible_scene) {
+          // Only joints that moved since the last update are recomputed
+          const glm::vec3 joints = glm::mix(previous_arm_state.joints, current_arm_state.joints, alpha);
+          arm.setJointAngles(joints.x, joints.y, joints.z);
+          arm.update();
+        }
+        /* TODO#2: Render a cylinder at target_pos
+         *       1. Translate to target_pos
+         *       2. Setup vertex color
+         *       3. Setup cylinder scale
+         *       4. Append an instance of the shared unit cylinder
+         * Hint: 
+         *       glTranslatef (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glTranslate.xml)
+         *       glColor3f (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glColor.xml)
+         *       glScalef (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glScale.xml)
+         * Note:
+         *       The coordinates of the cylinder are `target_pos`
+         *       The cylinder's size can refer to `TARGET_RADIUS`, `TARGET_DIAMETER` and `TARGET_DIAMETER`
+         *       The cylinder's color can refer to `RED`
+         */
+
+        /* TODO#3: Render the robotic arm
+         *       1. Render the base
+         *       2. Translate to top of the base
+         *       3. Render an arm
+         *       4. Translate to top of the arm
+         *       5. Render the joint
+         *       6. Translate and rotate to top of the join
+         *       7. Repeat step 3-6
+         * Hint:
+         *       glPushMatrix/glPopMatrix (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glPushMatrix.xml)
+         *       glRotatef (https://registry.khronos.org/OpenGL-Refpages/gl2.1/xhtml/glRotate.xml)
+         * Note:
+         *       The size of every component can refer to `Components size definition` section
+         *       Rotate degree for joints are `joint0_degree`, `joint1_degree` and `joint2_degree`
+         *       You may implement drawBase, drawArm and drawJoin first
+         */
+        if (visible_scene) {
+          // Each chunk of arms adds its targets and parts on whichever thread picks it up
+          cylinder_instances.build(jobs, visible_scene->size(),
+                                   [&](std::size_t begin, std::size_t end, LodInstances::Sink& sink) {
+                                     for (std::size_t i = begin; i < end; ++i) {
+                                       addTarget(sink, visible_scene->getTargetPosition(i, alpha),
+                                                 visible_scene->getBasePosition(i));
+                                     }
+                                     visible_scene->forEachPart(
+                                         [&](const glm::mat4& model, RobotArm::Part part, std::size_t index) {
+                                           sink.add(model, getPartColor(part, visible_scene->getContacts(index)));
+                                         },
+                                         alpha, begin, end);
+                                   });
+        } else {
+          cylinder_instances.build(jobs, 1, [&](std::size_t, std::size_t, LodInstances::Sink& sink) {
+            addTarget(sink, glm::mix(previous_arm_state.target, current_arm_state.target, alpha), glm::vec3(0.0f));
+            for (int part = 0; part < RobotArm::PART_COUNT; ++part) {
+              sink.add(arm.getPartModel(static_cast<RobotArm::Part>(part)),
+                       getPartColor(static_cast<RobotArm::Part>(part), current_arm_state.contacts));
+            }
+          });
+        }
+      },
+      {camera_task, simulate_task});
+  // Main rendering loop
+  while (!glfwWindowShouldClose(window)) {
+    // Polling events.
+    glfwPollEvents();
+    // Seconds since the first frame, this frame's input and time come from the log when replaying
+    frame_time = glfwGetTime() - start_time;
+    if (input_player) {
+      try {
+        if (!input_player->next(logged_frame)) break;
+      } catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        break;
+      }
+      for (const input_log::KeyAction& key : logged_frame.keys) handleKey(window, key.key, key.action);
+      frame_time = logged_frame.time;
+      camera_input = logged_frame.camera;
+    } else {
+      camera_input = camera.pollInput(window);
     }
-    glEnd();
-    glPopMatrix();
-
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, ARM_LEN + JOINT_DIAMETER, 0.0f);
-    glRotatef(joint2_degree, 1, 0, 0);
-    glScalef(JOINT_WIDTH, JOINT_DIAMETER / 2, JOINT_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(-1.0f, 0.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float y = sin(innerRadian);
-      glVertex3f(-0.5f, y, z);
+    if (recorder) recorder->writeFrame(frame_time, camera_input);
+    visible_scene = scene ? &scene->getRenderState() : nullptr;
+    if (simulation) {
+      snapshot = &simulation->acquire();
+      visible_scene = &snapshot->scene;
     }
-    glEnd();
-    glPopMatrix();
+    jobs.run(frame_graph);
 
-    // Arm3==============================================================
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, ARM_LEN + JOINT_DIAMETER, 0.0f);
-    glRotatef(joint2_degree, 1, 0, 0);
-    glTranslatef(0.0f, JOINT_RADIUS, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER / 2);
-    glBegin(GL_TRIANGLE_STRIP);
-    glColor3f(BLUE);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float x = sin(innerRadian);
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * (i - 0.5) / CIRCLE_SEGMENT);
-      float nz = cos(innerRadian);
-      float nx = sin(innerRadian);
-      glNormal3f(nx, 0.0f, nz);
-      glVertex3f(x, 1.0f, z);
-      glVertex3f(x, 0.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
+    // GL_XXX_BIT can simply "OR" together to use.
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    /// TO DO Enable DepthTest
+    GLState::enable(GL_DEPTH_TEST);
+    GLState::depthFunc(GL_LEQUAL);
 
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, ARM_LEN + JOINT_DIAMETER, 0.0f);
-    glRotatef(joint2_degree, 1, 0, 0);
-    glTranslatef(0.0f, JOINT_RADIUS, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(0.0f, 1.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float z = cos(innerRadian);
-      float x = sin(innerRadian);
-      glVertex3f(x, 1.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
+#ifndef DISABLE_LIGHT   
+    GLState::clearColor(glm::vec4(0.0f, 0.0f, 0.0f, 0.0f));
+    glClear(GL_COLOR_BUFFER_BIT);
+    GLState::clearDepth(1.0f);
+    renderer->beginFrame(view, projection, light, true);
+#else
+    renderer->beginFrame(view, projection, light, false);
+#endif
 
-    glPushMatrix();
-    glRotatef(joint0_degree, 0, 1, 0);
-    glTranslatef(0.0f, BASE_HEIGHT + ARM_LEN + JOINT_RADIUS, 0.0f);
-    glRotatef(joint1_degree, 1, 0, 0);
-    glTranslatef(0.0f, ARM_LEN + JOINT_DIAMETER, 0.0f);
-    glRotatef(joint2_degree, 1, 0, 0);
-    glTranslatef(0.0f, JOINT_RADIUS, 0.0f);
-    glScalef(ARM_DIAMETER / 2, ARM_LEN, ARM_DIAMETER / 2);
-    glBegin(GL_POLYGON);
-    glNormal3f(0.0f, -1.0f, 0.0f);
-    for (float i = 0; i <= CIRCLE_SEGMENT; i += 1.0f) {
-      innerRadian = ANGEL_TO_RADIAN(innerAngle * i / CIRCLE_SEGMENT);
-      float x = cos(innerRadian);
-      float z = sin(innerRadian);
-      glVertex3f(x, 0.0f, z);
+    // Render a white board, then every cylinder part with one call per detail level
+    renderer->draw(board, board_instances);
+    for (std::size_t level = 0; level < CylinderLod::LEVEL_COUNT; ++level) {
+      renderer->draw(cylinder_lod.getMesh(level), cylinder_instances.get(level));
     }
-    glEnd();
-    glPopMatrix();
 
 #ifdef __APPLE__
     // Some platform need explicit glFlush
     glFlush();
 #endif
+    if (frame_capture) frame_capture->capture(OpenGLContext::getWidth(), OpenGLContext::getHeight());
     glfwSwapBuffers(window);
+    frame_pacer.endFrame();
+    gl_frame_stats = GLState::newFrame();
+    gl_max_elided = std::max(gl_max_elided, gl_frame_stats.elided);
+    ++frame_count;
+    if (options.frames > 0 && frame_count >= static_cast<std::uint64_t>(options.frames)) {
+      glfwSetWindowShouldClose(window, GLFW_TRUE);
+    }
+  }
+  if (simulation) {
+    simulation->stop();
+    input_latency = simulation->getInputLatency();
+  }
+  if (input_latency.events > 0) {
+    std::cout << "Input latency: " << input_latency.getMean() << " ms mean, " << input_latency.max_ms << " ms max over "
+              << input_latency.events << " events (" << dropped_input_events << " dropped)" << std::endl;
+  }
+  if (input_player || recorder) {
+    // Runs of the same log end in the same state, whatever build or speed they ran at
+    const glm::vec3 target = scene ? scene->getTargetPosition(0) : target_pos;
+    std::cout << "Final state after " << timestep.getTime() << " s: joints (" << control.joints.x << ", "
+              << control.joints.y << ", " << control.joints.z << "), target (" << target.x << ", " << target.y << ", "
+              << target.z << ")" << std::endl;
+  }
+  const MotionPlanner::Stats& plan_stats = planner.getStats();
+  if (plan_stats.plans > 0) {
+    std::cout << "Planning: " << plan_stats.getMean() << " ms mean, " << plan_stats.max_ms << " ms max, "
+              << plan_stats.found << " of " << plan_stats.plans << " plans found a path" << std::endl;
+  }
+  const FramePacer::Stats& frame_stats = frame_pacer.getStats();
+  if (frame_stats.frames > 0) {
+    std::cout << "Frame time: " << frame_stats.mean << " ms mean, " << frame_stats.jitter << " ms jitter, "
+              << frame_stats.max << " ms max over " << frame_stats.frames << " frames" << std::endl;
+    std::cout << "GL state calls: " << gl_frame_stats.elided << " elided, " << gl_frame_stats.issued
+              << " issued in the last frame, up to " << gl_max_elided << " elided per frame" << std::endl;
+  }
+  if (options.headless && frame_count > 0) {
+    // Offscreen swaps do not wait for the GPU, so include the queued work in the measurement
+    glFinish();
+    const double elapsed = glfwGetTime() - start_time;
+    std::cout << "Rendered " << frame_count << " frames in " << elapsed << " s (" << elapsed * 1000.0 / frame_count
+              << " ms/frame)" << std::endl;
   }
   return 0;
 }
@@ -0,0 +1,82 @@
+#include "mesh.h"
+
+#include <cstddef>
+#include <utility>
+
+Mesh::Mesh(const Vertex* vertices, std::size_t num_vertices, const GLuint* indices, std::size_t num_indices)
+    : index_count(static_cast<GLsizei>(num_indices)) {
+  glGenBuffers(1, &vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, num_vertices * sizeof(Vertex), vertices, GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  // Upload through GL_ARRAY_BUFFER too, element array binding is vertex array state in core profile.
+  glGenBuffers(1, &ibo);
+  glBindBuffer(GL_ARRAY_BUFFER, ibo);
+  glBufferData(GL_ARRAY_BUFFER, num_indices * sizeof(GLuint), indices, GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+Mesh::Mesh(Mesh&& other) noexcept
+    : vbo(std::exchange(other.vbo, 0)),
+      ibo(std::exchange(other.ibo, 0)),
+      index_count(std::exchange(other.index_count, 0)) {}
+
+Mesh& Mesh::operator=(Mesh&& other) noexcept {
+  if (this != &other) {
+    release();
+    vbo = std::exchange(other.vbo, 0);
+    ibo = std::exchange(other.ibo, 0);
+    index_count = std::exchange(other.index_count, 0);
+  }
+  return *this;
+}
+
+Mesh::~Mesh() { release(); }
+
+void Mesh::release() {
+  if (vbo != 0) glDeleteBuffers(1, &vbo);
+  if (ibo != 0) glDeleteBuffers(1, &ibo);
+  vbo = ibo = 0;
+  index_count = 0;
+}
+
+Mesh Mesh::createUnitPlane() {
+  constexpr glm::vec3 normal(0.0f, 1.0f, 0.0f);
+  std::vector<Vertex> vertices{
+      {glm::vec3(-1.0f, 0.0f, -1.0f), normal},
+      {glm::vec3(-1.0f, 0.0f, 1.0f), normal},
+      {glm::vec3(1.0f, 0.0f, -1.0f), normal},
+      {glm::vec3(1.0f, 0.0f, 1.0f), normal},
+  };
+  std::vector<GLuint> indices{1, 3, 2, 1, 2, 0};
+  return Mesh(vertices, indices);
+}
+
+void Mesh::draw() const {
+  bind();
+  glDrawElements(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, nullptr);
+  unbind();
+}
+
+void Mesh::drawInstanced(GLsizei instance_count) const {
+  bind();
+  glDrawElementsInstanced(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, nullptr, instance_count);
+  unbind();
+}
+
+void Mesh::bind() const {
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_NORMAL_ARRAY);
+  glVertexPointer(3, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, position)));
+  glNormalPointer(GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, normal)));
+}
+
+void Mesh::unbind() const {
+  glDisableClientState(GL_NORMAL_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,162 @@
+#include "motion_planner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "arm_collision.h"
+
+namespace {
+/// @brief Targets are placed here so only board, base and self contacts count.
+const glm::vec3 NO_TARGET(0.0f, -100.0f, 0.0f);
+}  // namespace
+
+std::uint32_t MotionPlanner::Tree::add(const glm::vec3& node, std::uint32_t parent) {
+  nodes.push_back(node);
+  parents.push_back(parent);
+  return static_cast<std::uint32_t>(nodes.size() - 1);
+}
+
+std::uint32_t MotionPlanner::Tree::nearest(const glm::vec3& pose) const {
+  std::uint32_t best = 0;
+  float best_distance2 = INFINITY;
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    const glm::vec3 offset = nodes[i] - pose;
+    const float distance2 = glm::dot(offset, offset);
+    if (distance2 < best_distance2) {
+      best_distance2 = distance2;
+      best = static_cast<std::uint32_t>(i);
+    }
+  }
+  return best;
+}
+
+bool MotionPlanner::isFree(const glm::vec3& pose) {
+  return collision::checkPose(pose.x, pose.y, pose.z, NO_TARGET) == collision::NONE;
+}
+
+float MotionPlanner::checkEdge(const glm::vec3& from, const glm::vec3& to, float resolution_degree) {
+  const std::size_t count =
+      std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(glm::length(to - from) / resolution_degree)));
+  if (joint0.size() < count) {
+    for (std::vector<float>* plane : {&joint0, &joint1, &joint2, &zero}) plane->resize(count, 0.0f);
+    far_below.resize(count, NO_TARGET.y);
+    contacts.resize(count);
+  }
+  // Pose k is at (k + 1) / count of the edge, from itself was checked when it was added
+  for (std::size_t k = 0; k < count; ++k) {
+    const glm::vec3 pose = glm::mix(from, to, static_cast<float>(k + 1) / static_cast<float>(count));
+    joint0[k] = pose.x;
+    joint1[k] = pose.y;
+    joint2[k] = pose.z;
+  }
+  jobs.parallelFor(count, CHECK_GRAIN, [&](std::size_t begin, std::size_t end) {
+    collision::checkBatch(joint0.data() + begin, joint1.data() + begin, joint2.data() + begin, zero.data() + begin,
+                          zero.data() + begin, zero.data() + begin, far_below.data() + begin, zero.data() + begin,
+                          end - begin, contacts.data() + begin);
+  });
+  checked_poses += count;
+  const std::size_t first_hit =
+      static_cast<std::size_t>(std::find_if(contacts.begin(), contacts.begin() + count,
+                                            [](std::uint8_t contact) { return contact != collision::NONE; }) -
+                               contacts.begin());
+  return static_cast<float>(first_hit) / static_cast<float>(count);
+}
+
+std::uint32_t MotionPlanner::extend(Tree& tree, const glm::vec3& pose, const Settings& settings) {
+  const std::uint32_t near = tree.nearest(pose);
+  const glm::vec3 from = tree.nodes[near];
+  const float distance = glm::length(pose - from);
+  const glm::vec3 to =
+      distance > settings.step_degree ? from + (pose - from) * (settings.step_degree / distance) : pose;
+  if (checkEdge(from, to, settings.resolution_degree) < 1.0f) return ROOT;
+  return tree.add(to, near);
+}
+
+std::uint32_t MotionPlanner::connect(Tree& tree, const glm::vec3& pose, const Settings& settings, bool& reached) {
+  std::uint32_t node = tree.nearest(pose);
+  const glm::vec3 from = tree.nodes[node];
+  const float free = checkEdge(from, pose, settings.resolution_degree);
+  reached = free >= 1.0f;
+  // Chain nodes along the free part, keeping them one step apart like extend() would
+  const float distance = glm::length(pose - from) * free;
+  const int steps = static_cast<int>(std::ceil(distance / settings.step_degree));
+  for (int step = 1; step <= steps; ++step) {
+    const float t = free * static_cast<float>(step) / static_cast<float>(steps);
+    node = tree.add(step == steps && reached ? pose : glm::mix(from, pose, t), node);
+  }
+  return node;
+}
+
+std::vector<glm::vec3> MotionPlanner::shortcut(const std::vector<glm::vec3>& path, const Settings& settings) {
+  std::vector<glm::vec3> result{path.front()};
+  std::size_t i = 0;
+  while (i + 1 < path.size()) {
+    std::size_t j = path.size() - 1;
+    while (j > i + 1 && checkEdge(path[i], path[j], settings.resolution_degree) < 1.0f) --j;
+    result.push_back(path[j]);
+    i = j;
+  }
+  return result;
+}
+
+MotionPlanner::Result MotionPlanner::plan(const glm::vec3& start, const glm::vec3& goal, const Settings& settings) {
+  const auto begin = std::chrono::steady_clock::now();
+  checked_poses = 0;
+  Result result{{}, false, 0, 0, 0.0};
+  Tree from_start, from_goal;
+  from_start.add(start, ROOT);
+  from_goal.add(goal, ROOT);
+  std::uint32_t start_node = ROOT, goal_node = ROOT;
+
+  if (isFree(goal)) {
+    // Sample the usual joint range, grown to include poses wound past it
+    const glm::vec3 low = glm::min(glm::min(start, goal), glm::vec3(-180.0f));
+    const glm::vec3 high = glm::max(glm::max(start, goal), glm::vec3(180.0f));
+    std::mt19937 random(settings.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    bool reached = false;
+    // Try the straight line first, the trees only grow if it is blocked
+    connect(from_goal, start, settings, reached);
+    if (reached) {
+      start_node = 0;
+      goal_node = static_cast<std::uint32_t>(from_goal.nodes.size() - 1);
+    }
+    Tree* grow = &from_start;
+    Tree* other = &from_goal;
+    for (; start_node == ROOT && result.iterations < settings.max_iterations; ++result.iterations) {
+      const glm::vec3 sample = low + (high - low) * glm::vec3(unit(random), unit(random), unit(random));
+      const std::uint32_t added = extend(*grow, sample, settings);
+      if (added != ROOT) {
+        const std::uint32_t joined = connect(*other, grow->nodes[added], settings, reached);
+        if (reached) {
+          start_node = grow == &from_start ? added : joined;
+          goal_node = grow == &from_start ? joined : added;
+        }
+      }
+      std::swap(grow, other);
+    }
+  }
+
+  if (start_node != ROOT) {
+    // The start tree is walked back to its root, the goal tree forwards to its own
+    for (std::uint32_t node = start_node; node != ROOT; node = from_start.parents[node]) {
+      result.path.push_back(from_start.nodes[node]);
+    }
+    std::reverse(result.path.begin(), result.path.end());
+    // The joining node is in both trees
+    for (std::uint32_t node = from_goal.parents[goal_node]; node != ROOT; node = from_goal.parents[node]) {
+      result.path.push_back(from_goal.nodes[node]);
+    }
+    if (settings.shortcut) result.path = shortcut(result.path, settings);
+    result.found = true;
+  }
+  result.checked_poses = checked_poses;
+  result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+  ++stats.plans;
+  stats.found += result.found ? 1 : 0;
+  stats.total_ms += result.milliseconds;
+  stats.max_ms = std::max(stats.max_ms, result.milliseconds);
+  return result;
+}
@@ -9,6 +9,7 @@ int OpenGLContext::refresh_rate = 60;
 int OpenGLContext::major_version = 4;
 int OpenGLContext::minor_version = 1;
 int OpenGLContext::profile = GLFW_OPENGL_COMPAT_PROFILE;
+bool OpenGLContext::headless = false;
 int OpenGLContext::framebuffer_width = 1280;
 int OpenGLContext::framebuffer_height = 720;
 
@@ -116,6 +117,10 @@ void GLAPIENTRY errorCallback(GLenum source, GLenum type, GLuint id, GLenum seve
 OpenGLContext::OpenGLContext() {
   // Initialize GLFW
   if (glfwInit() == GLFW_FALSE) {
+    if (headless) {
+      THROW_EXCEPTION(std::runtime_error,
+                      "Failed to initialize GLFW! Build with -DGLFW_USE_OSMESA=ON to run without a display.");
+    }
     THROW_EXCEPTION(std::runtime_error, "Failed to initialize GLFW!");
   }
   // Setup context property
@@ -128,6 +133,11 @@ OpenGLContext::OpenGLContext() {
 #ifndef NDEBUG
   glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
 #endif
+  if (headless) {
+    // The OSMesa backend renders into client memory, the window is never shown
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+  }
   // Create OpenGL context
   window = glfwCreateWindow(1280, 720, "Hello World!", nullptr, nullptr);
   if (window == nullptr) {
@@ -139,7 +149,8 @@ OpenGLContext::OpenGLContext() {
     if (window == nullptr) THROW_EXCEPTION(std::runtime_error, "Failed to create OpenGL context!");
   }
   glfwMakeContextCurrent(window);
-  glfwSwapInterval(1);
+  // There is no display to synchronize with offscreen
+  glfwSwapInterval(headless ? 0 : 1);
   // Load OpenGL function pointers
 #ifdef GLAD_OPTION_GL_ON_DEMAND
   // Lazy loading
@@ -166,9 +177,10 @@ OpenGLContext::~OpenGLContext() {
   glfwTerminate();
 }
 
-void OpenGLContext::createContext(int GLversion, int profile) {
+void OpenGLContext::createContext(int GLversion, int profile, bool headless) {
   // We should only initialize once
   if (window == nullptr) {
+    OpenGLContext::headless = headless;
     OpenGLContext::major_version = GLversion / 10;
     OpenGLContext::minor_version = GLversion % 10;
     if (GLversion < 32)
@@ -180,18 +192,19 @@ void OpenGLContext::createContext(int GLversion, int profile) {
 }
 
 void OpenGLContext::printSystemInfo() {
+  std::cout << std::left << std::setw(26) << "Current OpenGL renderer"
+            << ": " << glGetString(GL_RENDERER) << std::endl;
+  std::cout << std::left << std::setw(26) << "Current OpenGL context"
+            << ": " << glGetString(GL_VERSION) << std::endl;
+  // Headless runs have no monitor
   GLFWmonitor* moniter = glfwGetPrimaryMonitor();
-  const GLFWvidmode* vidMode = glfwGetVideoMode(moniter);
+  const GLFWvidmode* vidMode = moniter == nullptr ? nullptr : glfwGetVideoMode(moniter);
   if (vidMode == nullptr) {
     std::cerr << "Unable to get video mode of monitor." << std::endl;
     return;
   }
   OpenGLContext::refresh_rate = vidMode->refreshRate;
 
-  std::cout << std::left << std::setw(26) << "Current OpenGL renderer"
-            << ": " << glGetString(GL_RENDERER) << std::endl;
-  std::cout << std::left << std::setw(26) << "Current OpenGL context"
-            << ": " << glGetString(GL_VERSION) << std::endl;
   std::cout << std::left << std::setw(26) << "Moniter refresh rate"
             << ": " << refresh_rate << " Hz" << std::endl;
 }
@@ -0,0 +1,112 @@
+#include "options.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "reach_map.h"
+#include "utils.h"
+
+namespace {
+/// @brief Consume the value that follows an option.
+std::string nextValue(int& i, int argc, char** argv, const std::string& option) {
+  if (i + 1 >= argc) THROW_EXCEPTION(std::invalid_argument, option + " needs a value");
+  return argv[++i];
+}
+
+/// @brief Parse a positive number, the whole string must be consumed.
+template <typename T>
+T parsePositive(const std::string& value, const std::string& option) {
+  std::size_t parsed = 0;
+  T result{};
+  try {
+    if constexpr (std::is_integral_v<T>) {
+      result = static_cast<T>(std::stoi(value, &parsed));
+    } else {
+      result = static_cast<T>(std::stod(value, &parsed));
+    }
+  } catch (const std::exception&) {
+    parsed = 0;
+  }
+  if (parsed == 0 || parsed != value.size() || !(result > 0)) {
+    THROW_EXCEPTION(std::invalid_argument, "Invalid value for " + option + ": " + value);
+  }
+  return result;
+}
+}  // namespace
+
+Options Options::parse(int argc, char** argv) {
+  Options options;
+  const char* headless_env = std::getenv("HW1_HEADLESS");
+  options.headless = headless_env != nullptr && *headless_env != '\0' && std::string(headless_env) != "0";
+  bool has_frames = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string argument(argv[i]);
+    if (argument == "--core") {
+      options.core_profile = true;
+    } else if (argument == "--headless") {
+      options.headless = true;
+    } else if (argument == "--frames") {
+      options.frames = parsePositive<int>(nextValue(i, argc, argv, argument), argument);
+      has_frames = true;
+    } else if (argument == "--capture") {
+      options.capture_directory = nextValue(i, argc, argv, argument);
+    } else if (argument == "--vsync") {
+      std::string value = nextValue(i, argc, argv, argument);
+      if (value == "on") {
+        options.vsync = VsyncMode::ON;
+      } else if (value == "off") {
+        options.vsync = VsyncMode::OFF;
+      } else if (value == "adaptive") {
+        options.vsync = VsyncMode::ADAPTIVE;
+      } else {
+        THROW_EXCEPTION(std::invalid_argument, "Invalid value for --vsync: " + value);
+      }
+    } else if (argument == "--fps") {
+      options.fps = parsePositive<double>(nextValue(i, argc, argv, argument), argument);
+    } else if (argument == "--threaded") {
+      options.threaded = true;
+    } else if (argument == "--sim-rate") {
+      options.sim_rate = parsePositive<double>(nextValue(i, argc, argv, argument), argument);
+    } else if (argument == "--reach-map") {
+      options.reach_map_path = nextValue(i, argc, argv, argument);
+    } else if (argument == "--record") {
+      options.record_path = nextValue(i, argc, argv, argument);
+    } else if (argument == "--replay") {
+      options.replay_path = nextValue(i, argc, argv, argument);
+    } else if (argument == "--arms") {
+      options.arms = parsePositive<int>(nextValue(i, argc, argv, argument), argument);
+    } else {
+      THROW_EXCEPTION(std::invalid_argument, "Unknown option: " + argument);
+    }
+  }
+  if (!options.record_path.empty() && !options.replay_path.empty()) {
+    THROW_EXCEPTION(std::invalid_argument, "--record and --replay cannot be combined");
+  }
+  // The simulation thread steps on its own clock, which a log cannot reproduce
+  if (options.threaded && (!options.record_path.empty() || !options.replay_path.empty())) {
+    THROW_EXCEPTION(std::invalid_argument, "--record and --replay need the simulation on the render thread");
+  }
+  if (options.reach_map_path.empty()) options.reach_map_path = ReachMap::getDefaultPath(argv[0]).string();
+  // Nothing can close an invisible window, so headless runs always stop by themselves, replays at the end of the log
+  if (options.headless && !has_frames && options.replay_path.empty()) options.frames = DEFAULT_HEADLESS_FRAMES;
+  return options;
+}
+
+void Options::printUsage(const char* program) {
+  std::cout << "Usage: " << program << " [options]" << std::endl
+            << "  --core        Use an OpenGL core-profile context with the shader renderer" << std::endl
+            << "  --headless    Render offscreen without a display (or set HW1_HEADLESS=1)" << std::endl
+            << "  --frames N    Exit after N frames, headless runs default to " << DEFAULT_HEADLESS_FRAMES << std::endl
+            << "  --capture DIR Write every frame to DIR as PPM images" << std::endl
+            << "  --vsync MODE  Swap interval: on (default), off or adaptive" << std::endl
+            << "  --fps N       Limit the frame rate to N frames per second" << std::endl
+            << "  --arms N      Render N arms on a grid, all but the first one are animated" << std::endl
+            << "  --sim-rate HZ Simulation steps per second, 60 by default" << std::endl
+            << "  --threaded    Run the simulation on its own thread" << std::endl
+            << "  --reach-map F Reachability map file, reach_map.bin next to the program by default" << std::endl
+            << "  --record FILE Record keyboard and camera input to FILE" << std::endl
+            << "  --replay FILE Replay input recorded to FILE, then exit" << std::endl;
+}
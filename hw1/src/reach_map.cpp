@@ -0,0 +1,187 @@
+#include "reach_map.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "arm_collision.h"
+
+struct ReachMap::Header {
+  char magic[4];
+  std::uint32_t version;
+  std::uint64_t dimension_hash;
+  std::int32_t size[3];
+  std::uint32_t word_count;
+};
+
+namespace {
+constexpr char MAGIC[4] = {'H', 'W', 'R', 'M'};
+constexpr std::uint32_t VERSION = 2;
+
+/// @brief FNV-1a over the bytes of value.
+template <typename T>
+void hashValue(std::uint64_t& hash, const T& value) {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  for (unsigned char byte : bytes) hash = (hash ^ byte) * 0x100000001b3ull;
+}
+
+/// @return Contents of path if it has at least size bytes, empty otherwise.
+std::vector<char> readPrefix(const std::filesystem::path& path, std::size_t size) {
+  std::ifstream file(path, std::ios::binary);
+  std::vector<char> data(size);
+  if (!file.read(data.data(), static_cast<std::streamsize>(size))) data.clear();
+  return data;
+}
+}  // namespace
+
+std::uint64_t ReachMap::getDimensionHash() {
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  for (float value : {ARM_LEN, ARM_RADIUS, JOINT_RADIUS, BASE_RADIUS, BASE_HEIGHT, CATCH_POSITION_OFFSET, TOLERANCE,
+                      VOXEL_SIZE, ANGLE_STEP_DEGREE, ORIGIN.x, ORIGIN.y, ORIGIN.z}) {
+    hashValue(hash, value);
+  }
+  return hash;
+}
+
+ReachMap::ReachMap(const std::filesystem::path& path) {
+  if (!isCurrent(path)) {
+    THROW_EXCEPTION(std::runtime_error, "Reach map " + path.string() + " is missing or baked for other dimensions");
+  }
+  mapping_size = sizeof(Header) + WORD_COUNT * sizeof(std::uint64_t);
+#ifdef _WIN32
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file != INVALID_HANDLE_VALUE) {
+    file_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The mapping keeps the file open
+    CloseHandle(file);
+  }
+  if (file_mapping) mapping = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, mapping_size);
+  if (!mapping) THROW_EXCEPTION(std::runtime_error, "Failed to map " + path.string());
+#else
+  const int file = open(path.c_str(), O_RDONLY);
+  if (file >= 0) {
+    mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps the file open
+    close(file);
+  }
+  if (mapping == MAP_FAILED || !mapping) {
+    mapping = nullptr;
+    THROW_EXCEPTION(std::runtime_error, "Failed to map " + path.string());
+  }
+#endif
+  bits = reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(mapping) + sizeof(Header));
+}
+
+ReachMap::~ReachMap() {
+#ifdef _WIN32
+  if (mapping) UnmapViewOfFile(mapping);
+  if (file_mapping) CloseHandle(file_mapping);
+#else
+  if (mapping) munmap(mapping, mapping_size);
+#endif
+}
+
+std::filesystem::path ReachMap::getDefaultPath(const char* program) {
+  std::filesystem::path executable(program);
+#ifdef __linux__
+  // argv[0] has no directory when the program was found through PATH
+  std::error_code error;
+  const std::filesystem::path resolved = std::filesystem::read_symlink("/proc/self/exe", error);
+  if (!error) executable = resolved;
+#endif
+  return executable.parent_path() / "reach_map.bin";
+}
+
+bool ReachMap::isCurrent(const std::filesystem::path& path) {
+  const std::vector<char> data = readPrefix(path, sizeof(Header));
+  if (data.empty()) return false;
+  Header header;
+  std::memcpy(&header, data.data(), sizeof(Header));
+  std::error_code error;
+  const std::uintmax_t file_size = std::filesystem::file_size(path, error);
+  return !error && std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+         header.dimension_hash == getDimensionHash() && header.size[0] == SIZE.x && header.size[1] == SIZE.y &&
+         header.size[2] == SIZE.z && header.word_count == WORD_COUNT &&
+         file_size == sizeof(Header) + WORD_COUNT * sizeof(std::uint64_t);
+}
+
+void ReachMap::bake(const std::filesystem::path& path, unsigned thread_count) {
+  static_assert(sizeof(Header) % sizeof(std::uint64_t) == 0, "Bits must start 8-byte aligned");
+  const int steps = static_cast<int>(360.0f / ANGLE_STEP_DEGREE);
+  const std::size_t poses = static_cast<std::size_t>(steps) * steps;
+  thread_count = std::max(1u, thread_count);
+  // Each thread takes every thread_count-th yaw into its own bitset, merged at the end
+  std::vector<std::vector<std::uint64_t>> partial(thread_count, std::vector<std::uint64_t>(WORD_COUNT, 0));
+  auto sweep = [&](unsigned thread) {
+    std::vector<float> joint0(poses), joint1(poses), joint2(poses), x(poses), y(poses), z(poses);
+    // Targets are out of the way, only board, base and self contacts rule a pose out
+    std::vector<float> zero(poses, 0.0f), far_below(poses, -100.0f);
+    std::vector<std::uint8_t> contacts(poses);
+    for (std::size_t i = 0; i < poses; ++i) {
+      joint1[i] = -180.0f + static_cast<float>(i / steps) * ANGLE_STEP_DEGREE;
+      joint2[i] = -180.0f + static_cast<float>(i % steps) * ANGLE_STEP_DEGREE;
+    }
+    std::vector<std::uint64_t>& words = partial[thread];
+    for (int yaw = static_cast<int>(thread); yaw < steps; yaw += static_cast<int>(thread_count)) {
+      std::fill(joint0.begin(), joint0.end(), -180.0f + static_cast<float>(yaw) * ANGLE_STEP_DEGREE);
+      kinematics::forwardBatch(joint0.data(), joint1.data(), joint2.data(), poses, x.data(), y.data(), z.data());
+      collision::checkBatch(joint0.data(), joint1.data(), joint2.data(), zero.data(), zero.data(), zero.data(),
+                            far_below.data(), zero.data(), poses, contacts.data());
+      for (std::size_t i = 0; i < poses; ++i) {
+        if (contacts[i] != collision::NONE) continue;
+        const glm::ivec3 cell(glm::floor((glm::vec3(x[i], y[i], z[i]) - ORIGIN) * (1.0f / VOXEL_SIZE)));
+        if (glm::any(glm::lessThan(cell, glm::ivec3(0))) || glm::any(glm::greaterThanEqual(cell, SIZE))) continue;
+        const std::size_t index = (static_cast<std::size_t>(cell.y) * SIZE.z + cell.z) * SIZE.x + cell.x;
+        words[index / 64] |= std::uint64_t(1) << (index % 64);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned thread = 1; thread < thread_count; ++thread) threads.emplace_back(sweep, thread);
+  sweep(0);
+  for (std::thread& thread : threads) thread.join();
+  for (unsigned thread = 1; thread < thread_count; ++thread) {
+    for (std::size_t i = 0; i < WORD_COUNT; ++i) partial[0][i] |= partial[thread][i];
+  }
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.dimension_hash = getDimensionHash();
+  header.size[0] = SIZE.x;
+  header.size[1] = SIZE.y;
+  header.size[2] = SIZE.z;
+  header.word_count = static_cast<std::uint32_t>(WORD_COUNT);
+  // Write next to the target and rename, a reader never maps a half-written file
+  std::filesystem::path temporary = path;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(partial[0].data()),
+               static_cast<std::streamsize>(WORD_COUNT * sizeof(std::uint64_t)));
+    if (!file) THROW_EXCEPTION(std::runtime_error, "Failed to write " + temporary.string());
+  }
+  std::filesystem::rename(temporary, path);
+}
@@ -0,0 +1,7 @@
+#include "renderer.h"
+
+#include <glm/gtc/matrix_inverse.hpp>
+
+Instance Instance::create(const glm::mat4& model, const glm::vec3& color) {
+  return {model, glm::inverseTranspose(glm::mat3(model)), color};
+}
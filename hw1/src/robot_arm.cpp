@@ -0,0 +1,55 @@
+#include "robot_arm.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "arm_dimensions.h"
+
+namespace {
+constexpr glm::vec3 X_AXIS(1.0f, 0.0f, 0.0f);
+constexpr glm::vec3 Y_AXIS(0.0f, 1.0f, 0.0f);
+}  // namespace
+
+RobotArm::RobotArm(const glm::vec3& base_position) {
+  const glm::mat4 arm_scale = getPartShape(ARM1);
+  const glm::mat4 joint_scale = getPartShape(JOINT1);
+  const glm::mat4 base_scale = getPartShape(BASE);
+  const glm::vec3 zero(0.0f);
+
+  root = graph.addNode(TransformGraph::NO_PARENT, base_position);
+  parts[BASE] = graph.addNode(root, zero, Y_AXIS, base_scale);
+  // Joint0 turns the whole arm around the vertical axis on top of the base
+  joints[0] = graph.addNode(root, glm::vec3(0.0f, BASE_HEIGHT, 0.0f), Y_AXIS);
+  parts[ARM1] = graph.addNode(joints[0], zero, Y_AXIS, arm_scale);
+  joints[1] = graph.addNode(joints[0], glm::vec3(0.0f, ARM_LEN + JOINT_RADIUS, 0.0f), X_AXIS);
+  parts[JOINT1] = graph.addNode(joints[1], zero, Y_AXIS, joint_scale);
+  parts[ARM2] = graph.addNode(joints[1], glm::vec3(0.0f, JOINT_RADIUS, 0.0f), Y_AXIS, arm_scale);
+  joints[2] = graph.addNode(joints[1], glm::vec3(0.0f, JOINT_RADIUS + ARM_LEN + JOINT_RADIUS, 0.0f), X_AXIS);
+  parts[JOINT2] = graph.addNode(joints[2], zero, Y_AXIS, joint_scale);
+  parts[ARM3] = graph.addNode(joints[2], glm::vec3(0.0f, JOINT_RADIUS, 0.0f), Y_AXIS, arm_scale);
+  end_effector = graph.addNode(joints[2], glm::vec3(0.0f, JOINT_RADIUS + ARM_LEN + CATCH_POSITION_OFFSET, 0.0f));
+  graph.update();
+}
+
+glm::mat4 RobotArm::getPartShape(Part part) {
+  // Unit cylinder is along +y, joints lie along x and are centered at their pivot
+  switch (part) {
+    case BASE:
+      return glm::scale(glm::mat4(1.0f), glm::vec3(BASE_RADIUS, BASE_HEIGHT, BASE_RADIUS));
+    case JOINT1:
+    case JOINT2: {
+      const glm::mat4 joint_align = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(-0.5f, 0.0f, 0.0f)),
+                                                ANGEL_TO_RADIAN(-90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+      return glm::scale(glm::mat4(1.0f), glm::vec3(JOINT_WIDTH, JOINT_RADIUS, JOINT_RADIUS)) * joint_align;
+    }
+    default:
+      return glm::scale(glm::mat4(1.0f), glm::vec3(ARM_RADIUS, ARM_LEN, ARM_RADIUS));
+  }
+}
+
+void RobotArm::setJointAngles(float joint0_degree, float joint1_degree, float joint2_degree) {
+  graph.setAngle(joints[0], joint0_degree);
+  graph.setAngle(joints[1], joint1_degree);
+  graph.setAngle(joints[2], joint2_degree);
+}
+
+void RobotArm::setBasePosition(const glm::vec3& position) { graph.setOffset(root, position); }
@@ -0,0 +1,81 @@
+#include "shader.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "gl_state.h"
+
+ShaderProgram::ShaderProgram(const std::string& vertex_source, const std::string& fragment_source,
+                             const std::vector<AttributeBinding>& attributes) {
+  GLuint vertex_shader = compile(GL_VERTEX_SHADER, vertex_source);
+  GLuint fragment_shader = 0;
+  try {
+    fragment_shader = compile(GL_FRAGMENT_SHADER, fragment_source);
+  } catch (...) {
+    glDeleteShader(vertex_shader);
+    throw;
+  }
+  program = glCreateProgram();
+  glAttachShader(program, vertex_shader);
+  glAttachShader(program, fragment_shader);
+  for (const auto& attribute : attributes) {
+    glBindAttribLocation(program, attribute.location, attribute.name);
+  }
+  glLinkProgram(program);
+  // Shaders can be flagged for deletion once attached, they are freed with the program.
+  glDeleteShader(vertex_shader);
+  glDeleteShader(fragment_shader);
+
+  GLint success = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (success == GL_FALSE) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+    std::string log(length, '\0');
+    glGetProgramInfoLog(program, length, nullptr, log.data());
+    release();
+    THROW_EXCEPTION(std::runtime_error, "Failed to link shader program:\n" + log);
+  }
+}
+
+ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept : program(std::exchange(other.program, 0)) {}
+
+ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
+  if (this != &other) {
+    release();
+    program = std::exchange(other.program, 0);
+  }
+  return *this;
+}
+
+ShaderProgram::~ShaderProgram() { release(); }
+
+void ShaderProgram::use() const { GLState::useProgram(program); }
+
+GLuint ShaderProgram::compile(GLenum type, const std::string& source) {
+  GLuint shader = glCreateShader(type);
+  const char* source_pointer = source.c_str();
+  glShaderSource(shader, 1, &source_pointer, nullptr);
+  glCompileShader(shader);
+
+  GLint success = GL_FALSE;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+  if (success == GL_FALSE) {
+    GLint length = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+    std::string log(length, '\0');
+    glGetShaderInfoLog(shader, length, nullptr, log.data());
+    glDeleteShader(shader);
+    THROW_EXCEPTION(std::runtime_error, "Failed to compile shader:\n" + log);
+  }
+  return shader;
+}
+
+void ShaderProgram::release() {
+  // Unbind first so the cached binding never refers to a deleted, possibly reused, name.
+  if (program != 0) {
+    GLState::useProgram(0);
+    glDeleteProgram(program);
+  }
+  program = 0;
+}
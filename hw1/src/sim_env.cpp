@@ -0,0 +1,71 @@
+#include "sim_env.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/constants.hpp>
+
+#include "arm_dimensions.h"
+#include "arm_kinematics.h"
+
+namespace {
+/// @brief Targets are placed this far from the base, clear of it and well within reach.
+constexpr float MIN_TARGET_DISTANCE = BASE_RADIUS + TARGET_RADIUS + 0.1f;
+constexpr float MAX_TARGET_DISTANCE = 1.8f;
+}  // namespace
+
+SimEnv::SimEnv(std::size_t count, std::uint32_t seed)
+    : random(seed),
+      joint0(count),
+      joint1(count),
+      joint2(count),
+      end_x(count),
+      end_y(count),
+      end_z(count),
+      target_x(count),
+      target_y(count),
+      target_z(count),
+      caught(count) {
+  reset();
+}
+
+void SimEnv::reset() {
+  for (std::size_t env = 0; env < size(); ++env) reset(env);
+}
+
+void SimEnv::reset(std::size_t env) {
+  std::uniform_real_distribution<float> angle(0.0f, glm::two_pi<float>());
+  std::uniform_real_distribution<float> distance(MIN_TARGET_DISTANCE, MAX_TARGET_DISTANCE);
+  joint0[env] = joint1[env] = joint2[env] = 0.0f;
+  const glm::vec3 end = kinematics::forward(0.0f, 0.0f, 0.0f);
+  end_x[env] = end.x;
+  end_y[env] = end.y;
+  end_z[env] = end.z;
+  const float direction = angle(random), radius = distance(random);
+  target_x[env] = radius * std::sin(direction);
+  target_y[env] = TARGET_HEIGHT / 2;
+  target_z[env] = radius * std::cos(direction);
+  caught[env] = 0;
+}
+
+void SimEnv::step(const Actions& actions, float dt) {
+  const std::size_t count = size();
+  for (std::size_t i = 0; i < count; ++i) {
+    joint0[i] += actions.joint0_delta[i];
+    joint1[i] += actions.joint1_delta[i];
+    joint2[i] += actions.joint2_delta[i];
+  }
+  kinematics::forwardBatch(joint0.data(), joint1.data(), joint2.data(), count, end_x.data(), end_y.data(),
+                           end_z.data());
+  const float fall = DROP_SPEED * dt;
+  for (std::size_t i = 0; i < count; ++i) {
+    const float dx = end_x[i] - target_x[i], dy = end_y[i] - target_y[i], dz = end_z[i] - target_z[i];
+    const bool catches = actions.grab[i] && dx * dx + dy * dy + dz * dz <= TOLERANCE * TOLERANCE;
+    caught[i] = catches ? 1 : 0;
+    // Branch-free so the loop vectorizes: a caught target follows the tip, a released one may fall
+    const float fallen = actions.drop[i] ? std::max(target_y[i] - fall, TARGET_HEIGHT / 2) : target_y[i];
+    target_x[i] = catches ? end_x[i] : target_x[i];
+    target_y[i] = catches ? end_y[i] : fallen;
+    target_z[i] = catches ? end_z[i] : target_z[i];
+  }
+}
@@ -0,0 +1,53 @@
+#include "simulation.h"
+
+#include <algorithm>
+
+Simulation::Simulation(std::size_t count, double step_seconds, InputQueue& events, MotionPlanner* planner,
+                       JobSystem* jobs)
+    : step(step_seconds), scene(count, jobs), input(events), output(Snapshot{scene.getRenderState(), Clock::now()}) {
+  control.planner = planner;
+  thread = std::thread(&Simulation::run, this);
+}
+
+Simulation::~Simulation() { stop(); }
+
+void Simulation::stop() {
+  running.store(false, std::memory_order_relaxed);
+  if (thread.joinable()) thread.join();
+}
+
+const Simulation::Snapshot& Simulation::acquire() {
+  output.update();
+  return output.front();
+}
+
+float Simulation::getAlpha(const Snapshot& snapshot) const {
+  const double alpha = std::chrono::duration<double>(Clock::now() - snapshot.published) / step;
+  return static_cast<float>(std::clamp(alpha, 0.0, 1.0));
+}
+
+void Simulation::run() {
+  const float dt = static_cast<float>(step.count());
+  const auto period = std::chrono::duration_cast<Clock::duration>(step);
+  Clock::time_point next = Clock::now();
+  std::uint64_t steps = 0;
+  while (running.load(std::memory_order_relaxed)) {
+    std::this_thread::sleep_until(next);
+    next += period;
+    if (Clock::now() - next > period * MAX_CATCH_UP_STEPS) next = Clock::now();
+
+    control.drain(input, scene.getTargetPosition(0), latency);
+    control.follow(dt);
+    scene.beginStep();
+    scene.setJointAngles(0, control.joints.x, control.joints.y, control.joints.z);
+    scene.setGrip(0, control.grab, control.drop);
+    scene.animate(static_cast<double>(++steps) * step.count());
+    scene.update(dt);
+
+    Snapshot& snapshot = output.back();
+    // Same size every step, so the planes are overwritten without reallocating
+    snapshot.scene = scene.getRenderState();
+    snapshot.published = Clock::now();
+    output.publish();
+  }
+}
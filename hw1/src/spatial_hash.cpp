@@ -0,0 +1,31 @@
+#include "spatial_hash.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "utils.h"
+
+SpatialHash::SpatialHash(float cell_size) : inverse_cell_size(1.0f / cell_size) {
+  if (!(cell_size > 0.0f)) THROW_EXCEPTION(std::invalid_argument, "Cell size must be positive");
+}
+
+void SpatialHash::insert(std::uint32_t id, const glm::vec3& position) {
+  if (id != cells.size()) {
+    THROW_EXCEPTION(std::invalid_argument, "Expected point " + std::to_string(cells.size()) + ", got " +
+                                                std::to_string(id));
+  }
+  cells.push_back(getCell(position));
+  grid[cells.back()].push_back(id);
+}
+
+void SpatialHash::update(std::uint32_t id, const glm::vec3& position) {
+  const glm::ivec3 cell = getCell(position);
+  if (cell == cells[id]) return;
+  // Order within a cell does not matter, swap the point with the last one and drop it
+  std::vector<std::uint32_t>& old_cell = grid[cells[id]];
+  *std::find(old_cell.begin(), old_cell.end(), id) = old_cell.back();
+  old_cell.pop_back();
+  grid[cell].push_back(id);
+  cells[id] = cell;
+}
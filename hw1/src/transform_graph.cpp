@@ -0,0 +1,54 @@
+#include "transform_graph.h"
+
+#include <stdexcept>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "utils.h"
+
+int TransformGraph::addNode(int parent, const glm::vec3& offset, const glm::vec3& axis, const glm::mat4& tail) {
+  if (parent >= static_cast<int>(parents.size())) {
+    THROW_EXCEPTION(std::out_of_range, "Parent node must be added before its children");
+  }
+  parents.push_back(parent);
+  offsets.push_back(offset);
+  axes.push_back(glm::normalize(axis));
+  angles.push_back(0.0f);
+  tails.push_back(tail);
+  world.emplace_back(1.0f);
+  dirty.push_back(true);
+  any_dirty = true;
+  return static_cast<int>(parents.size()) - 1;
+}
+
+void TransformGraph::setAngle(int node, float degrees) {
+  if (angles[node] == degrees) return;
+  angles[node] = degrees;
+  dirty[node] = any_dirty = true;
+}
+
+void TransformGraph::setOffset(int node, const glm::vec3& offset) {
+  if (offsets[node] == offset) return;
+  offsets[node] = offset;
+  dirty[node] = any_dirty = true;
+}
+
+std::size_t TransformGraph::update() {
+  if (!any_dirty) return 0;
+  std::size_t recomputed = 0;
+  // Parents come first, so a dirty parent has already been recomputed and flagged its children below.
+  for (std::size_t i = 0; i < parents.size(); ++i) {
+    int parent = parents[i];
+    if (parent != NO_PARENT && dirty[parent]) dirty[i] = true;
+    if (!dirty[i]) continue;
+    glm::mat4 local = glm::translate(glm::mat4(1.0f), offsets[i]);
+    if (angles[i] != 0.0f) local = glm::rotate(local, glm::radians(angles[i]), axes[i]);
+    local *= tails[i];
+    world[i] = parent == NO_PARENT ? local : world[parent] * local;
+    ++recomputed;
+  }
+  // Clear flags only after the pass, children read them above.
+  for (auto& flag : dirty) flag = false;
+  any_dirty = false;
+  return recomputed;
+}